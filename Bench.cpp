@@ -0,0 +1,232 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SearchEngine.h"
+#include "TestPositions.h"
+
+// =====================================================================================================================
+
+// measure the hot paths of the engine and write the results as JSON - usage: reversi_bench [json [maxDepth]]
+//
+// every benchmark runs on the same middle game positions for each board size, 4x4 .. 10x10: they are reached by
+// random moves from the start with a fixed seed, so they stay the same from release to release. The move generation
+// and the board operations report nano seconds per operation, the search reports the nodes per second for each depth
+// (one thread, an empty transposition table per position). The JSON goes to the given file, default: stdout.
+
+namespace
+{
+    /// @brief a position to measure and the side to move
+    struct Position
+    {
+        Reversi         reversi;                                            ///< the game
+        Reversi::Stone  toMove;                                             ///< stone to move, it has a move
+    };
+
+    /// @brief gives access to the protected parts of the game
+    class BenchReversi : public Reversi
+    {
+    public:
+        /*! @brief constructor
+         *
+         * @param reversi   game to copy
+         */
+        explicit BenchReversi( const Reversi& reversi )
+            : Reversi { reversi }
+        {}
+
+        using Reversi::checkNeighbor;
+    };
+
+    constexpr const int                 positionsPerSize { 8 };             ///< positions of each board size
+    constexpr const double              minTimeMs { 200.0 };                ///< run each benchmark at least that long
+    constexpr const size_t              hashSizeMB { 16 };                  ///< table of the search benchmark
+
+    volatile uint64_t                   g_Sink { 0 };                       ///< keeps results from being dropped
+
+    /*! @brief get the middle game positions of a board size
+     *
+     * @param size      size of the board
+     * @return          positions, half of the empty fields are filled
+     */
+    std::vector<Position> makePositions( const int size )
+    {
+        std::mt19937            random { TestPositions::randomSeed + static_cast<uint32_t>(size) };
+        std::vector<Position>   positions;
+
+        while( static_cast<int>(positions.size()) < positionsPerSize )
+        {
+            Reversi         reversi { size };
+            Reversi::Stone  toMove { Reversi::Stone::WhiteStone };
+            int             plies { ( size * size - 4 ) / 2 };
+
+            while( plies > 0 && TestPositions::makeRandomMove(reversi, toMove, random) )  // game over: try another one
+                --plies;
+
+            if( 0 == plies && reversi.getMoveCount(toMove) > 0 )
+                positions.push_back({ reversi, toMove });
+        }
+        return positions;
+    }
+
+    /*! @brief run an operation over all positions until the minimum time has passed
+     *
+     * @param positions     positions to run on
+     * @param op            operation on one position, returns the number of operations done
+     * @return              nano seconds per operation
+     */
+    template<typename Op>
+    double measure( std::vector<Position>& positions, Op op )
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const auto  start { Clock::now() };
+        uint64_t    ops { 0 };
+        double      ms { 0.0 };
+
+        do
+        {
+            for( auto& position : positions )
+                ops += op(position);
+
+            ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        } while( ms < minTimeMs );
+
+        return ms * 1e6 / std::max<uint64_t>(ops, 1);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+    const char* jsonPath { argc > 1 ? argv[1] : nullptr };
+    const int   maxDepth { argc > 2 ? std::atoi(argv[2]) : 8 };
+    FILE*       json { jsonPath ? std::fopen(jsonPath, "w") : stdout };
+    FILE*       table { jsonPath ? stdout : stderr };                           // keep the JSON on stdout clean
+    const char* separator { "" };
+    uint64_t    sink { 0 };                                                     // sum of results, see g_Sink
+
+    if( !json )
+    {
+        std::printf("can't write %s\n", jsonPath);
+        return 1;
+    }
+
+    std::fprintf(json, "{\n  \"positionsPerSize\": %d,\n  \"results\": [", positionsPerSize);
+    std::fprintf(table, "%-16s %6s %6s %12s %14s\n", "benchmark", "board", "depth", "ns/op", "nodes/s");
+
+    const auto report = [&]( const char* name, const int size, const int depth, const double nsPerOp,
+                             const uint64_t nodes, const double nodesPerSec )
+    {
+        std::fprintf(json, "%s\n    { \"name\": \"%s\", \"board\": %d, \"depth\": %d, \"nsPerOp\": %.1f, "
+                     "\"nodes\": %llu, \"nodesPerSec\": %.0f }", separator, name, size, depth, nsPerOp,
+                     static_cast<unsigned long long>(nodes), nodesPerSec);
+        std::fprintf(table, "%-16s %4dx%-2d %6d %12.1f %14.0f\n", name, size, size, depth, nsPerOp, nodesPerSec);
+        std::fflush(table);
+        separator = ",";
+    };
+
+    for( int size { 4 }; size <= 10; size += 2 )
+    {
+        std::vector<Position>   positions { makePositions(size) };
+        FieldList               moves;
+
+        report("getValidMoves", size, 0, measure(positions, [&moves, &sink]( Position& position )
+        {
+            position.reversi.getValidMoves(position.toMove, moves);
+            sink += moves.size();
+            return 1;
+        }), 0, 0.0);
+
+        std::vector<BenchReversi> games;                                        // every empty field, all directions
+
+        for( const auto& position : positions )
+            games.emplace_back(position.reversi);
+
+        report("checkNeighbor", size, 0, measure(positions, [&games, &positions, &sink, size]( Position& position )
+        {
+            const BenchReversi& game { games[&position - positions.data()] };
+            int                 ops { 0 };
+
+            for( int x { 0 }; x < size; ++x )
+                for( int y { 0 }; y < size; ++y )
+                {
+                    if( Reversi::Stone::NoStone != game.peekField({ x, y }) )
+                        continue;
+
+                    for( int dx { -1 }; dx <= 1; ++dx )
+                        for( int dy { -1 }; dy <= 1; ++dy )
+                        {
+                            if( 0 == dx && 0 == dy )
+                                continue;
+
+                            sink += game.checkNeighbor({ x, y }, { dx, dy }, position.toMove).getValue();
+                            ++ops;
+                        }
+                }
+            return ops;
+        }), 0, 0.0);
+
+        report("makeUndoMove", size, 0, measure(positions, [&moves]( Position& position )
+        {
+            position.reversi.getValidMoves(position.toMove, moves);                 // included, see getValidMoves
+
+            for( size_t i { 0 }; i < moves.size(); ++i )
+            {
+                position.reversi.makeMove(moves[i], position.toMove);
+                position.reversi.undoMove(moves[i]);
+            }
+            return static_cast<int>(moves.size());
+        }), 0, 0.0);
+
+        Reversi copy { size };
+
+        report("copyBoard", size, 0, measure(positions, [&copy, &sink]( Position& position )
+        {
+            copy  = position.reversi;
+            sink += copy.getHash();
+            return 1;
+        }), 0, 0.0);
+
+        SearchEngine engine { Reversi { size }, hashSizeMB };
+
+        for( int depth { 1 }; depth <= maxDepth; ++depth )
+        {
+            uint64_t    nodes { 0 };
+            double      ms { 0.0 };
+
+            for( const auto& position : positions )
+            {
+                engine.setHashSize(hashSizeMB);                                 // start with an empty table
+                engine.setPosition(position.reversi);
+
+                const auto                      start { std::chrono::steady_clock::now() };
+                const SearchEngine::MoveInfo    info { engine.computeNextMove(position.toMove, depth) };
+
+                ms    += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                nodes += info.nodes;
+            }
+
+            report("computeNextMove", size, depth, ms * 1e6 / positions.size(), nodes,
+                   nodes / std::max(ms, 1e-3) * 1000.0);
+        }
+    }
+
+    std::fprintf(json, "\n  ]\n}\n");
+
+    if( jsonPath )
+        std::fclose(json);
+
+    g_Sink = sink;
+    return 0;
+}
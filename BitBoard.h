@@ -0,0 +1,459 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// =====================================================================================================================
+
+/*! @brief 128 bit mask made of two 64-bit words, used for boards with more than 64 fields
+ * @details Only the operators needed by the bit-board are implemented, all of them are constexpr so that the masks
+ * of a board size can be computed at compile time.
+ */
+struct Bits128
+{
+    uint64_t    m_Low { 0 };                                                ///< bits 0 .. 63
+    uint64_t    m_High { 0 };                                               ///< bits 64 .. 127
+
+    constexpr Bits128() = default;
+
+    /*! @brief construct from a single word
+     *
+     * @param low       lower 64 bits
+     */
+    constexpr Bits128( const uint64_t low )
+        : m_Low { low }
+    {}
+
+    /*! @brief construct from both words
+     *
+     * @param low       lower 64 bits
+     * @param high      upper 64 bits
+     */
+    constexpr Bits128( const uint64_t low, const uint64_t high )
+        : m_Low { low }
+        , m_High { high }
+    {}
+
+    constexpr Bits128 operator<<( const int n ) const
+    {
+        if( n >= 64 ) return { 0, m_Low << ( n - 64 ) };
+        if( n == 0 )  return *this;
+        return { m_Low << n, ( m_High << n ) | ( m_Low >> ( 64 - n ) ) };
+    }
+
+    constexpr Bits128 operator>>( const int n ) const
+    {
+        if( n >= 64 ) return { m_High >> ( n - 64 ), 0 };
+        if( n == 0 )  return *this;
+        return { ( m_Low >> n ) | ( m_High << ( 64 - n ) ), m_High >> n };
+    }
+
+    constexpr Bits128 operator&( const Bits128& b ) const
+    { return { m_Low & b.m_Low, m_High & b.m_High }; }
+
+    constexpr Bits128 operator|( const Bits128& b ) const
+    { return { m_Low | b.m_Low, m_High | b.m_High }; }
+
+    constexpr Bits128 operator^( const Bits128& b ) const
+    { return { m_Low ^ b.m_Low, m_High ^ b.m_High }; }
+
+    constexpr Bits128 operator~() const
+    { return { ~m_Low, ~m_High }; }
+
+    constexpr Bits128& operator&=( const Bits128& b )
+    { m_Low &= b.m_Low; m_High &= b.m_High; return *this; }
+
+    constexpr Bits128& operator|=( const Bits128& b )
+    { m_Low |= b.m_Low; m_High |= b.m_High; return *this; }
+
+    constexpr Bits128& operator^=( const Bits128& b )
+    { m_Low ^= b.m_Low; m_High ^= b.m_High; return *this; }
+
+    constexpr bool operator==( const Bits128& b ) const
+    { return m_Low == b.m_Low && m_High == b.m_High; }
+
+    constexpr bool operator!=( const Bits128& b ) const
+    { return !( *this == b ); }
+
+    constexpr explicit operator bool() const
+    { return m_Low || m_High; }
+};
+
+// =====================================================================================================================
+
+/*! @brief helpers for counting and finding bits, for plain words and Bits128
+ *
+ */
+namespace BitOps
+{
+    /*! @brief number of set bits
+     *
+     * @param b         mask
+     * @return          number of fields in the mask
+     */
+    inline int popCount( const uint64_t b )
+    {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(b));
+#else
+        return __builtin_popcountll(b);
+#endif
+    }
+
+    inline int popCount( const Bits128& b )
+    { return popCount(b.m_Low) + popCount(b.m_High); }
+
+    /*! @brief index of the lowest set bit, the mask must not be empty
+     *
+     * @param b         mask
+     * @return          bit index
+     */
+    inline int lowestIndex( const uint64_t b )
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanForward64(&idx, b);
+        return static_cast<int>(idx);
+#else
+        return __builtin_ctzll(b);
+#endif
+    }
+
+    inline int lowestIndex( const Bits128& b )
+    { return b.m_Low ? lowestIndex(b.m_Low) : 64 + lowestIndex(b.m_High); }
+
+    /*! @brief remove the lowest set bit
+     *
+     * @param b         mask, must not be empty
+     * @return          mask without its lowest bit
+     */
+    inline uint64_t clearLowest( const uint64_t b )
+    { return b & ( b - 1 ); }
+
+    inline Bits128 clearLowest( const Bits128& b )
+    { return b.m_Low ? Bits128 { clearLowest(b.m_Low), b.m_High } : Bits128 { 0, clearLowest(b.m_High) }; }
+}
+
+// =====================================================================================================================
+
+/*! @brief NxN board coded as two bit masks, one per color
+ * @details This is the fast representation of the position used for move generation. Each field is a single bit,
+ * the index of field (x, y) is x * N + y - so iterating the bits in ascending order gives the same order as iterating
+ * the board coloumn by coloumn, which is how Reversi::getValidMoves always reported its moves. Boards up to 8x8 use a
+ * single 64-bit word, larger ones the two-word Bits128.
+ *
+ * Moving one field in a direction is a shift of the whole mask, fields that would "wrap around" into the next coloumn
+ * or fall off the board are masked out. All legal moves are generated at once via Kogge-Stone style occluded fills:
+ * starting at the own stones, runs of opposite stones are followed in every direction, the empty field behind such a
+ * run is a legal move. All masks are computed at compile time for each board size.
+ *
+ * It contains
+ * - the mask of black stones
+ * - the mask of white stones
+ *
+ * It implements
+ * - setting, removing and flipping a single stone
+ * - generating the mask of all legal moves for a color
+ * - computing the mask of stones flipped by a move
+ *
+ * @tparam Size     number of rows and coloumns
+ */
+template<int Size>
+class BitBoard
+{
+    static_assert( Size >= 4 && Size <= 10 && Size % 2 == 0, "unsupported board size" );
+
+public:
+    using Bits = std::conditional_t<( Size * Size <= 64 ), uint64_t, Bits128>;   ///< one bit per field
+
+    static constexpr const int  m_Size { Size };                            ///< number of rows and coloumns
+
+    /*! @brief get bit index of a field
+     *
+     * @param x         x coordinate
+     * @param y         y coordinate
+     * @return          index of the bit representing the field
+     */
+    static constexpr int index( const int x, const int y )
+    { return x * Size + y; }
+
+    /*! @brief get mask of all fields of the board
+     *
+     * @return          mask
+     */
+    static constexpr Bits getBoardMask()
+    { return m_BoardMask; }
+
+    /*! @brief get mask with a single field set
+     *
+     * @param idx       bit index of the field
+     * @return          mask
+     */
+    static constexpr Bits square( const int idx )
+    { return Bits { 1 } << idx; }
+
+    /*! @brief generate all legal moves
+     *
+     * @param own       stones of the color to move
+     * @param opp       stones of the opposite color
+     * @return          mask of empty fields where a stone may be placed
+     */
+    static constexpr Bits generateMoves( const Bits own, const Bits opp );
+
+    /*! @brief compute stones flipped when placing a stone on a field
+     *
+     * @param idx       bit index of the field to place the stone
+     * @param own       stones of the color to move
+     * @param opp       stones of the opposite color
+     * @return          mask of opposite stones that change color, empty if the move is illegal
+     */
+    static constexpr Bits computeFlips( const int idx, const Bits own, const Bits opp );
+
+    /*! @brief put a stone on an empty field
+     *
+     * @param idx       bit index
+     * @param white     true for a white stone, false for a black one
+     */
+    void set( const int idx, const bool white )
+    {
+        if( white ) m_White |= square(idx);
+        else        m_Black |= square(idx);
+    }
+
+    /*! @brief remove a stone of any color
+     *
+     * @param idx       bit index
+     */
+    void remove( const int idx )
+    {
+        m_White &= ~square(idx);
+        m_Black &= ~square(idx);
+    }
+
+    /*! @brief change color of a stone
+     *
+     * @param idx       bit index
+     */
+    void flip( const int idx )
+    {
+        m_White ^= square(idx);
+        m_Black ^= square(idx);
+    }
+
+    /*! @brief get stones of one color
+     *
+     * @param white     true for the white stones
+     * @return          mask
+     */
+    Bits getStones( const bool white ) const
+    { return white ? m_White : m_Black; }
+
+    /*! @brief get all legal moves for one color
+     *
+     * @param white     true if white is to move
+     * @return          mask of legal moves
+     */
+    Bits getMoves( const bool white ) const
+    { return generateMoves(getStones(white), getStones(!white)); }
+
+    /*! @brief get empty fields next to the stones of one color
+     *
+     * @param white     true for the white stones
+     * @return          mask of fields
+     */
+    Bits getAdjacent( const bool white ) const
+    { return neighborFields(getStones(white)) & ~( m_White | m_Black ); }
+
+    /*! @brief get stones flipped by a move
+     *
+     * @param idx       bit index of the move
+     * @param white     true if white is to move
+     * @return          mask of flipped stones
+     */
+    Bits getFlips( const int idx, const bool white ) const
+    { return computeFlips(idx, getStones(white), getStones(!white)); }
+
+private:
+    /*! @brief build a mask of all fields on the board, optionally without the first or last row
+     *
+     * @param withFirstRow  include fields with y == 0
+     * @param withLastRow   include fields with y == Size - 1
+     * @return              mask
+     */
+    static constexpr Bits rowMask( const bool withFirstRow, const bool withLastRow )
+    {
+        Bits mask {};
+
+        for( int x { 0 }; x < Size; ++x )
+        {
+            for( int y { withFirstRow ? 0 : 1 }; y < ( withLastRow ? Size : Size - 1 ); ++y )
+            {
+                mask |= square(index(x, y));
+            }
+        }
+        return mask;
+    }
+
+    static constexpr const Bits m_BoardMask   { rowMask(true, true) };      ///< all fields of the board
+    static constexpr const Bits m_NotFirstRow { rowMask(false, true) };     ///< all fields except y == 0
+    static constexpr const Bits m_NotLastRow  { rowMask(true, false) };     ///< all fields except y == Size - 1
+
+    /*! @brief shift a mask, positive values towards higher indices
+     *
+     * @tparam Shift    number of bits to shift
+     * @param b         mask
+     * @return          shifted mask
+     */
+    template<int Shift>
+    static constexpr Bits shift( const Bits b )
+    {
+        if constexpr ( Shift > 0 ) return b << Shift;
+        else                       return b >> -Shift;
+    }
+
+    /*! @brief get all fields next to a set of fields
+     *
+     * @param b         mask
+     * @return          mask of the neighbors, may include fields of b itself
+     */
+    static constexpr Bits neighborFields( const Bits b )
+    {
+        return ( shift<  1         >(b) & m_NotFirstRow ) | ( shift<  Size + 1  >(b) & m_NotFirstRow )
+             | ( shift<  Size      >(b) & m_BoardMask )   | ( shift<  Size - 1  >(b) & m_NotLastRow )
+             | ( shift< -1         >(b) & m_NotLastRow )  | ( shift<-(Size + 1) >(b) & m_NotLastRow )
+             | ( shift< -Size      >(b) & m_BoardMask )   | ( shift<-(Size - 1) >(b) & m_NotFirstRow );
+    }
+
+    /*! @brief Kogge-Stone occluded fill: extend the generator through the propagator in one direction
+     * @details runs of up to Size - 2 opposite stones have to be covered, so 2, 3 or 4 doubling steps are needed.
+     *
+     * @tparam Shift    direction as bit shift
+     * @param gen       generator, start of the fill
+     * @param pro       propagator, the fill may only extend over these fields
+     * @param mask      fields that can be reached by the shift without wrapping
+     * @return          generator plus all reachable propagator fields
+     */
+    template<int Shift>
+    static constexpr Bits fill( Bits gen, Bits pro, const Bits mask )
+    {
+        pro &= mask;
+        gen |= pro & shift<Shift>(gen);
+        pro &= shift<Shift>(pro);
+        gen |= pro & shift<2 * Shift>(gen);
+        if constexpr ( Size - 2 > 3 )
+        {
+            pro &= shift<2 * Shift>(pro);
+            gen |= pro & shift<4 * Shift>(gen);
+        }
+        if constexpr ( Size - 2 > 7 )
+        {
+            pro &= shift<4 * Shift>(pro);
+            gen |= pro & shift<8 * Shift>(gen);
+        }
+        return gen;
+    }
+
+    /*! @brief legal moves regarding a single direction
+     *
+     * @tparam Shift    direction as bit shift
+     * @param own       own stones
+     * @param opp       opposite stones
+     * @param mask      fields that can be reached by the shift without wrapping
+     * @return          empty or occupied fields behind a run of opposite stones
+     */
+    template<int Shift>
+    static constexpr Bits movesInDirection( const Bits own, const Bits opp, const Bits mask )
+    { return shift<Shift>(fill<Shift>(own, opp, mask) & opp) & mask; }
+
+    /*! @brief flips regarding a single direction
+     *
+     * @tparam Shift    direction as bit shift
+     * @param move      field of the move
+     * @param own       own stones
+     * @param opp       opposite stones
+     * @param mask      fields that can be reached by the shift without wrapping
+     * @return          run of opposite stones if it is closed by an own stone
+     */
+    template<int Shift>
+    static constexpr Bits flipsInDirection( const Bits move, const Bits own, const Bits opp, const Bits mask )
+    {
+        const Bits run { fill<Shift>(move, opp, mask) };
+
+        return ( shift<Shift>(run) & mask & own ) ? run & opp : Bits {};
+    }
+
+    Bits    m_Black {};                                                     ///< black stones
+    Bits    m_White {};                                                     ///< white stones
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// x + 1 is a shift by Size, y + 1 a shift by 1 - only shifts changing y may wrap into the neighboring coloumn
+template<int Size>
+constexpr typename BitBoard<Size>::Bits BitBoard<Size>::generateMoves( const Bits own, const Bits opp )
+{
+    const Bits empty { ~( own | opp ) & m_BoardMask };
+
+    const Bits moves { movesInDirection<  1         >(own, opp, m_NotFirstRow)    // north
+                     | movesInDirection<  Size + 1  >(own, opp, m_NotFirstRow)    // north-east
+                     | movesInDirection<  Size      >(own, opp, m_BoardMask)      // east
+                     | movesInDirection<  Size - 1  >(own, opp, m_NotLastRow)     // south-east
+                     | movesInDirection< -1         >(own, opp, m_NotLastRow)     // south
+                     | movesInDirection<-(Size + 1) >(own, opp, m_NotLastRow)     // south-west
+                     | movesInDirection< -Size      >(own, opp, m_BoardMask)      // west
+                     | movesInDirection<-(Size - 1) >(own, opp, m_NotFirstRow) }; // north-west
+    return moves & empty;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template<int Size>
+constexpr typename BitBoard<Size>::Bits BitBoard<Size>::computeFlips( const int idx, const Bits own, const Bits opp )
+{
+    const Bits move { square(idx) };
+
+    return flipsInDirection<  1         >(move, own, opp, m_NotFirstRow)
+         | flipsInDirection<  Size + 1  >(move, own, opp, m_NotFirstRow)
+         | flipsInDirection<  Size      >(move, own, opp, m_BoardMask)
+         | flipsInDirection<  Size - 1  >(move, own, opp, m_NotLastRow)
+         | flipsInDirection< -1         >(move, own, opp, m_NotLastRow)
+         | flipsInDirection<-(Size + 1) >(move, own, opp, m_NotLastRow)
+         | flipsInDirection< -Size      >(move, own, opp, m_BoardMask)
+         | flipsInDirection<-(Size - 1) >(move, own, opp, m_NotFirstRow);
+}
+
+// =====================================================================================================================
+
+/// one instantiation per allowed board size, the game picks the one matching its size
+using AnyBitBoard = std::variant<BitBoard<4>, BitBoard<6>, BitBoard<8>, BitBoard<10>>;
+
+/*! @brief create the empty bit-board instantiation for a board size
+ *
+ * @param size      size of the board
+ * @return          bit-board of that size
+ */
+inline AnyBitBoard makeBitBoard( const int size )
+{
+    switch( size )
+    {
+    case 4  : return BitBoard<4> {};
+    case 6  : return BitBoard<6> {};
+    case 8  : return BitBoard<8> {};
+    case 10 : return BitBoard<10> {};
+    default : throw std::logic_error("No bit-board for this board size");
+    }
+}
+
+#endif //BITBOARD_H
@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "OpeningBook.h"
+#include "SearchEngine.h"
+
+// =====================================================================================================================
+
+// build an opening book from a file of games - usage: book_builder <games> <book> [size [plies [depth]]]
+//
+// a game is one line of moves separated by blanks, a move is the letter of the coloumn (x) and the number of the row
+// (y + 1), e.g. "d3 c5 f6", lines starting with '#' are ignored. White moves first, as in the game, passes are not
+// written. The positions of the first plies of every game are analyzed to the given depth.
+
+namespace
+{
+    /// @brief a position to analyze
+    struct Position
+    {
+        Reversi         reversi;                                            ///< the game
+        Reversi::Stone  toMove;                                             ///< stone to move
+    };
+
+    /*! @brief parse a move
+     *
+     * @param token     move like "d3"
+     * @param size      size of the board
+     * @param pos       the position of the move
+     * @return          false if it is not a move on the board
+     */
+    bool parseMove( const std::string& token, const int size, Pos_Vect& pos )
+    {
+        if( token.size() < 2 || token[0] < 'a' || token[0] >= 'a' + size )
+            return false;
+
+        const int row { std::atoi(token.c_str() + 1) };
+
+        if( row < 1 || row > size )
+            return false;
+
+        pos = { token[0] - 'a', row - 1 };
+        return true;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+    if( argc < 3 )
+    {
+        std::printf("usage: book_builder <games> <book> [size [plies [depth]]]\n");
+        return 1;
+    }
+
+    const int size { argc > 3 ? std::atoi(argv[3]) : 8 };
+    const int plies { argc > 4 ? std::atoi(argv[4]) : 12 };
+    const int depth { argc > 5 ? std::atoi(argv[5]) : 10 };
+
+    std::ifstream games { argv[1] };
+
+    if( !games )
+    {
+        std::printf("can't read %s\n", argv[1]);
+        return 1;
+    }
+
+    std::unordered_map<uint64_t, Position>  positions;
+    std::string                             line;
+    int                                     lineNum { 0 };
+
+    while( std::getline(games, line) )                                              // collect the positions
+    {
+        ++lineNum;
+
+        if( line.empty() || '#' == line[0] )
+            continue;
+
+        std::istringstream  moves { line };
+        std::string         token;
+        Reversi             reversi { size };
+        Reversi::Stone      toMove { Reversi::Stone::WhiteStone };
+
+        for( int ply { 0 }; ply < plies && moves >> token; ++ply )
+        {
+            FieldList validMoves { reversi.getValidMoves(toMove) };
+
+            if( 0 == validMoves.size() )                                            // pass
+            {
+                toMove     = Reversi::otherColor(toMove);
+                validMoves = reversi.getValidMoves(toMove);
+            }
+
+            positions.emplace(OpeningBook::makeKey(reversi, toMove), Position { reversi, toMove });
+
+            Pos_Vect    pos { 0, 0 };
+            int         idx { -1 };
+
+            if( parseMove(token, size, pos) )
+                for( size_t i { 0 }; i < validMoves.size(); ++i )
+                {
+                    const Pos_Vect& move { validMoves[i].getFieldPosition() };
+
+                    if( move.getX() == pos.getX() && move.getY() == pos.getY() )
+                        idx = static_cast<int>(i);
+                }
+
+            if( idx < 0 )
+            {
+                std::printf("line %d: invalid move %s, rest of the game skipped\n", lineNum, token.c_str());
+                break;
+            }
+
+            reversi.makeMove(validMoves[idx], toMove);
+            toMove = Reversi::otherColor(toMove);
+        }
+    }
+
+    std::vector<OpeningBook::Entry> entries;
+    SearchEngine                    engine { Reversi { size } };
+
+    engine.setThreads(static_cast<int>(std::thread::hardware_concurrency()));
+
+    for( const auto& position : positions )                                         // analyze them
+    {
+        engine.setPosition(position.second.reversi);
+
+        const SearchEngine::MoveInfo info { engine.computeNextMove(position.second.toMove, depth) };
+
+        if( info.idx < 0 )
+            continue;
+
+        entries.push_back({ position.first, static_cast<int16_t>(info.score),
+                            static_cast<uint8_t>(info.pos.getX() << 4 | info.pos.getY()),
+                            static_cast<uint8_t>(info.depth), 0 });
+
+        std::printf("\r%zu / %zu positions", entries.size(), positions.size());
+        std::fflush(stdout);
+    }
+    std::printf("\n");
+
+    if( !OpeningBook::write(argv[2], size, entries) )
+    {
+        std::printf("can't write %s\n", argv[2]);
+        return 1;
+    }
+
+    std::printf("%zu positions written to %s\n", entries.size(), argv[2]);
+    return 0;
+}
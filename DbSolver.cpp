@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PerfectPlayDB.h"
+#include "SearchEngine.h"
+
+// =====================================================================================================================
+
+// solve a small board with perfect play of both sides and write the database - usage: db_solver <size> <db> [plies]
+//
+// every position reachable from the start within the given number of plies (4x4 default: all) is scored with its
+// exact final disc difference. Positions are searched once per canonical key, positions at the ply limit are solved by
+// a search of the engine to the end of the game - sharing one transposition table. White moves first, as in the game.
+//
+// The 4x4 board is solved completely in a moment. The 6x6 board is far too large for that, so the plies have to be
+// given. Each position at the limit is a solve of 32 - plies empty fields, which takes (optimized build, one core)
+// about 5 s at 24 empty fields, 30 s at 26, 5 min at 28 - and a few times more for every ply less. Any 6x6 database
+// takes hours to days therefore, the fewer plies the fewer but the harder the positions to solve.
+
+namespace
+{
+    /// @brief solves positions by a full negamax over all moves, remembering every score
+    class DbSolver
+    {
+    public:
+        /*! @brief constructor
+         *
+         * @param size      size of the board
+         * @param maxPly    positions up to this ply are stored, the ones at this ply are solved by the engine
+         */
+        DbSolver( const int size, const int maxPly )
+            : m_MaxPly { maxPly }
+            , m_Engine { Reversi { size }, m_HashSizeMB }
+        {
+            m_Engine.setThreads(static_cast<int>(std::thread::hardware_concurrency()));
+        }
+
+        /*! @brief solve a position
+         *
+         * @param reversi   the game, restored on return
+         * @param stone     stone to move
+         * @param ply       number of plies from the start
+         * @param passed    true if the opponent just passed
+         * @return          final disc difference from the view of stone
+         */
+        int solve( Reversi& reversi, const Reversi::Stone stone, const int ply, const bool passed = false )
+        {
+            const uint64_t  key { PerfectPlayDB::canonicalKey(reversi, stone) };
+            const auto      known { m_Scores.find(key) };
+
+            if( m_Scores.end() != known )
+                return known->second;
+
+            const Reversi::Stone    other { Reversi::otherColor(stone) };
+            const FieldList         moves { reversi.getValidMoves(stone) };
+            int                     score { -INT_MAX };
+
+            if( 0 == moves.size() )
+                score = passed ? discDifference(reversi, stone) : -solve(reversi, other, ply, true);
+            else if( ply >= m_MaxPly )
+                score = solveExact(reversi, stone);
+            else
+            {
+                for( size_t i { 0 }; i < moves.size(); ++i )
+                {
+                    reversi.makeMove(moves[i], stone);
+                    score = std::max(score, -solve(reversi, other, ply + 1));
+                    reversi.undoMove(moves[i]);
+                }
+            }
+
+            m_Scores.emplace(key, static_cast<int8_t>(score));
+
+            if( 0 == m_Scores.size() % 100000 )
+            {
+                std::printf("\r%zu positions", m_Scores.size());
+                std::fflush(stdout);
+            }
+            return score;
+        }
+
+        /*! @brief get all solved positions
+         *
+         * @return          entries of the database
+         */
+        std::vector<PerfectPlayDB::Entry> getEntries() const
+        {
+            std::vector<PerfectPlayDB::Entry> entries;
+
+            entries.reserve(m_Scores.size());
+
+            for( const auto& score : m_Scores )
+                entries.push_back({ score.first, score.second });
+
+            return entries;
+        }
+
+    private:
+        /*! @brief final disc difference
+         *
+         * @param reversi   the game
+         * @param stone     stone to score
+         * @return          disc difference from the view of stone
+         */
+        static int discDifference( const Reversi& reversi, const Reversi::Stone stone )
+        {
+            const int diff { reversi.getWhiteNum() - reversi.getBlackNum() };
+
+            return Reversi::Stone::WhiteStone == stone ? diff : -diff;
+        }
+
+        /*! @brief solve a position by a search of the engine to the end of the game
+         *
+         * @param reversi   the game
+         * @param stone     stone to move, must have a move
+         * @return          final disc difference from the view of stone
+         */
+        int solveExact( const Reversi& reversi, const Reversi::Stone stone )
+        {
+            m_Engine.setPosition(reversi);
+
+            const int score { m_Engine.computeNextMove(stone, reversi.getBoardSize()).score };
+
+            return score > SearchEngine::m_WinScore    ? score - SearchEngine::m_WinScore
+                 : score < -SearchEngine::m_WinScore   ? score + SearchEngine::m_WinScore
+                 :                                       0;
+        }
+
+        static constexpr const size_t           m_HashSizeMB { 256 };       ///< table of the engine
+
+        const int                               m_MaxPly;                   ///< last ply to store
+        SearchEngine                            m_Engine;                   ///< solves the positions at the limit
+        std::unordered_map<uint64_t, int8_t>    m_Scores;                   ///< score per canonical key
+    };
+
+    /// @brief usage and run time, the 6x6 board needs the plies
+    const char* const m_Usage {
+        "usage: db_solver <size> <db> [plies]\n"
+        "       size 4: all positions by default, well below a second\n"
+        "       size 6: plies required, every position at the limit takes about 5 s with 24 empty fields, 30 s with\n"
+        "               26, 5 min with 28 (optimized build, one core) - hours to days in total\n" };
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+    if( argc < 3 )
+    {
+        std::printf("%s", m_Usage);
+        return 1;
+    }
+
+    const int size { std::atoi(argv[1]) };
+    const int plies { argc > 3 ? std::atoi(argv[3]) : size * size };
+
+    if( ( 4 != size && 6 != size ) || ( 6 == size && argc < 4 ) )
+    {
+        std::printf("%s", m_Usage);
+        return 1;
+    }
+
+    Reversi     reversi { size };
+    DbSolver    solver { size, plies };
+    const auto  start { std::chrono::steady_clock::now() };
+    const int   score { solver.solve(reversi, Reversi::Stone::WhiteStone, 0) };
+    const auto  entries { solver.getEntries() };
+    const auto  seconds { std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+    std::printf("\rsolved %zu positions in %.1f s, perfect play gives white %+d\n", entries.size(), seconds, score);
+
+    if( !PerfectPlayDB::write(argv[2], size, entries) )
+    {
+        std::printf("can't write %s\n", argv[2]);
+        return 1;
+    }
+
+    std::printf("written to %s\n", argv[2]);
+    return 0;
+}
@@ -0,0 +1,434 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef ENDGAMESOLVER_H
+#define ENDGAMESOLVER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include "BitBoard.h"
+
+// =====================================================================================================================
+
+/*! @brief exact solver of the end of a game, working on the bit-board only
+ * @details When only a few empty fields are left, the game can be searched to its very end and the final disc
+ * difference is known exactly. The solver doesn't use lists of moves or the game, just the two masks of stones: a move
+ * is the field plus the mask of flipped stones, making or taking it back is an xor.
+ *
+ * The order of moves is what makes the solver fast:
+ * - fastest first: with many empty fields left, the moves leaving the fewest replies to the opponent are tried first
+ * - parity: the board is split into four quadrants, moves into a quadrant with an odd number of empty fields are tried
+ *   first - playing last in a region is an advantage
+ *
+ * The last 3, 2 and 1 empty fields are handled by special functions that just try these fields, and the very last
+ * move only counts the flips to get the final score, without making the move.
+ *
+ * The score is the disc difference at the end of the game, from the view of the side to move. A search with the null
+ * window (-1, 1) just finds out if the game is won, lost or a draw - which is a lot faster than the exact score.
+ *
+ * Like the time, a cancellation - e.g. of the task of a parallel search the solver runs for - is checked from time to
+ * time, the solver gives up then and its result is meaningless.
+ *
+ * @tparam Size     number of rows and coloumns
+ */
+template<int Size>
+class EndgameSolver
+{
+public:
+    using Board = BitBoard<Size>;                                       ///< bit-board of the size
+    using Bits  = typename Board::Bits;                                 ///< one bit per field
+    using Cancelled = std::function<bool()>;                            ///< true if the result isn't needed any more
+
+    /*! @brief constructor
+     *
+     * @param stop      stop-flag, checked from time to time - set if the time is up
+     * @param deadline  end of the time budget
+     * @param cancelled checked from time to time as well, empty if the solve can't be cancelled
+     */
+    EndgameSolver( std::atomic<bool>& stop, const std::chrono::steady_clock::time_point deadline,
+                   Cancelled cancelled = {} )
+        : m_Stop { stop }
+        , m_Deadline { deadline }
+        , m_Cancelled { std::move(cancelled) }
+    {}
+
+    /*! @brief solve a position
+     *
+     * @param own       stones of the color to move
+     * @param opp       stones of the opposite color
+     * @param alpha     lower bound of the window
+     * @param beta      upper bound of the window
+     * @param bestIdx   bit index of the best move, -1 if there is no move
+     * @return          final disc difference from the view of the side to move - fail-soft, so if outside the window
+     *                  just a bound; no result if stopped
+     */
+    int solve( const Bits own, const Bits opp, const int alpha, const int beta, int& bestIdx )
+    {
+        bestIdx = -1;
+        return search(own, opp, alpha, beta, false, &bestIdx);
+    }
+
+    /*! @brief get the number of positions visited
+     *
+     * @return          number of positions
+     */
+    uint64_t getNodeCount() const
+    { return m_NodeCount; }
+
+    /*! @brief check if the last solve gave up because it was cancelled
+     *
+     * @return          true if so, its result is meaningless then
+     */
+    bool isCancelled() const
+    { return m_IsCancelled; }
+
+private:
+    static constexpr const int      m_Infinity { 1 << 20 };             ///< above any score
+    static constexpr const int      m_FastestFirstEmpties { 7 };        ///< min. empty fields to order by mobility
+    static constexpr const int      m_MaxMoves { Size * Size };         ///< more than moves of a position
+    static constexpr const uint64_t m_TimeCheckMask { 4095 };           ///< check the time every 4096 positions
+
+    /// a move: field and flipped stones
+    struct Move
+    {
+        int     idx;                                                    ///< bit index of the field
+        Bits    flips;                                                  ///< flipped stones
+        int     key;                                                    ///< ordering key, lowest first
+    };
+
+    /*! @brief build the masks of the four quadrants of the board
+     *
+     * @return          mask per quadrant
+     */
+    static constexpr std::array<Bits, 4> quadrantMasks()
+    {
+        std::array<Bits, 4> quadrants {};
+
+        for( int x { 0 }; x < Size; ++x )
+            for( int y { 0 }; y < Size; ++y )
+                quadrants[( x >= Size / 2 ? 2 : 0 ) + ( y >= Size / 2 ? 1 : 0 )] |= Board::square(Board::index(x, y));
+
+        return quadrants;
+    }
+
+    static constexpr const std::array<Bits, 4> m_Quadrants { quadrantMasks() };     ///< fields per quadrant
+
+    /*! @brief get the fields of all quadrants with an odd number of empty fields
+     *
+     * @param empty     empty fields
+     * @return          mask
+     */
+    static Bits oddQuadrants( const Bits empty )
+    {
+        Bits odd {};
+
+        for( const auto& quadrant : m_Quadrants )
+            if( BitOps::popCount(empty & quadrant) & 1 )
+                odd |= quadrant;
+
+        return odd;
+    }
+
+    /*! @brief final disc difference
+     *
+     * @param own       stones of the color to move
+     * @param opp       stones of the opposite color
+     * @return          score
+     */
+    static int finalScore( const Bits own, const Bits opp )
+    { return BitOps::popCount(own) - BitOps::popCount(opp); }
+
+    /*! @brief count a visited position, from time to time check if the time is up or the solve is cancelled
+     *
+     * @return          true if the search is stopped or cancelled
+     */
+    bool stopped()
+    {
+        if( 0 == ( ++m_NodeCount & m_TimeCheckMask ) )
+        {
+            if( std::chrono::steady_clock::now() >= m_Deadline )
+                m_Stop = true;
+
+            if( m_Cancelled && m_Cancelled() )
+                m_IsCancelled = true;
+        }
+        return halted();
+    }
+
+    /*! @brief check if the search has to give up, without counting a position
+     *
+     * @return          true if the search is stopped or cancelled
+     */
+    bool halted() const
+    { return m_IsCancelled || m_Stop.load(std::memory_order_relaxed); }
+
+    /*! @brief search a position to the end of the game
+     *
+     * @param own       stones of the color to move
+     * @param opp       stones of the opposite color
+     * @param alpha     lower bound of the window
+     * @param beta      upper bound of the window
+     * @param passed    true if the opponent just passed
+     * @param bestIdx   if not nullptr: gets the bit index of the best move
+     * @return          final disc difference, fail-soft
+     */
+    int search( const Bits own, const Bits opp, int alpha, const int beta, const bool passed, int* bestIdx );
+
+    /*! @brief search a position with 3 empty fields left
+     *
+     * @param own       stones of the color to move
+     * @param opp       stones of the opposite color
+     * @param alpha     lower bound of the window
+     * @param beta      upper bound of the window
+     * @param fields    bit indices of the empty fields
+     * @param passed    true if the opponent just passed
+     * @return          final disc difference, fail-soft
+     */
+    int last3( const Bits own, const Bits opp, int alpha, const int beta, const std::array<int, 3>& fields,
+               const bool passed );
+
+    /*! @brief search a position with 2 empty fields left
+     *
+     * @param own       stones of the color to move
+     * @param opp       stones of the opposite color
+     * @param alpha     lower bound of the window
+     * @param beta      upper bound of the window
+     * @param field1    bit index of the first empty field
+     * @param field2    bit index of the second empty field
+     * @param passed    true if the opponent just passed
+     * @return          final disc difference, fail-soft
+     */
+    int last2( const Bits own, const Bits opp, int alpha, const int beta, const int field1, const int field2,
+               const bool passed );
+
+    /*! @brief get the final score of a position with 1 empty field left
+     *
+     * @param own       stones of the color to move
+     * @param opp       stones of the opposite color
+     * @param field     bit index of the empty field
+     * @return          final disc difference
+     */
+    int last1( const Bits own, const Bits opp, const int field );
+
+    std::atomic<bool>&                      m_Stop;                     ///< stop-flag
+    std::chrono::steady_clock::time_point   m_Deadline;                 ///< end of the time budget
+    const Cancelled                         m_Cancelled;                ///< cancellation check, may be empty
+    bool                                    m_IsCancelled { false };    ///< gave up, cancelled
+    uint64_t                                m_NodeCount { 0 };          ///< positions visited
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// negamax principal variation search over the moves of the bit-board, ordered by mobility and parity
+
+template<int Size>
+int EndgameSolver<Size>::search( const Bits own, const Bits opp, int alpha, const int beta, const bool passed,
+                                 int* bestIdx )
+{
+    if( stopped() )
+        return 0;
+
+    const Bits  empty { ~( own | opp ) & Board::getBoardMask() };
+    const int   empties { BitOps::popCount(empty) };
+
+    if( empties <= 3 && !bestIdx )                                                  // no move to report: done by the
+    {                                                                               //      special functions
+        std::array<int, 3>  fields {};
+        Bits                remaining { empty };
+
+        for( int i { 0 }; i < empties; ++i, remaining = BitOps::clearLowest(remaining) )
+            fields[i] = BitOps::lowestIndex(remaining);
+
+        switch( empties )
+        {
+        case 3  : return last3(own, opp, alpha, beta, fields, passed);
+        case 2  : return last2(own, opp, alpha, beta, fields[0], fields[1], passed);
+        case 1  : return last1(own, opp, fields[0]);
+        default : return finalScore(own, opp);
+        }
+    }
+
+    Bits moveMask { Board::generateMoves(own, opp) };
+
+    if( !moveMask )                                                                 // pass - or game over
+        return passed ? finalScore(own, opp) : -search(opp, own, -beta, -alpha, true, nullptr);
+
+    const Bits                      odd { oddQuadrants(empty) };
+    std::array<Move, m_MaxMoves>    moves;
+    int                             numMoves { 0 };
+
+    for( ; moveMask; moveMask = BitOps::clearLowest(moveMask) )
+    {
+        Move& move { moves[numMoves++] };
+
+        move.idx   = BitOps::lowestIndex(moveMask);
+        move.flips = Board::computeFlips(move.idx, own, opp);
+        move.key   = ( odd & Board::square(move.idx) ) ? 0 : 1;                     // odd quadrants first
+
+        if( empties > m_FastestFirstEmpties )                                       // fewest replies first
+        {
+            const Bits newOwn { own | move.flips | Board::square(move.idx) };
+
+            move.key += 2 * BitOps::popCount(Board::generateMoves(opp ^ move.flips, newOwn));
+        }
+    }
+
+    for( int i { 1 }; i < numMoves; ++i )                                           // insertion sort, few moves
+    {
+        const Move  move { moves[i] };
+        int         j { i };
+
+        for( ; j > 0 && moves[j - 1].key > move.key; --j )
+            moves[j] = moves[j - 1];
+
+        moves[j] = move;
+    }
+
+    int bestScore { -m_Infinity };
+
+    for( int i { 0 }; i < numMoves; ++i )
+    {
+        const Move& move { moves[i] };
+        const Bits  newOwn { opp ^ move.flips };                                    // the opponent is to move next
+        const Bits  newOpp { own | move.flips | Board::square(move.idx) };
+        int         score { 0 };
+
+        if( 0 == i )
+            score = -search(newOwn, newOpp, -beta, -alpha, false, nullptr);
+        else
+        {
+            score = -search(newOwn, newOpp, -alpha - 1, -alpha, false, nullptr);    // prove it is not better
+            if( score > alpha && score < beta )
+                score = -search(newOwn, newOpp, -beta, -alpha, false, nullptr);     // it is, get the exact score
+        }
+
+        if( halted() )
+            return 0;
+
+        if( score > bestScore )
+        {
+            bestScore = score;
+            if( bestIdx ) *bestIdx = move.idx;
+        }
+
+        if( bestScore > alpha ) alpha = bestScore;
+        if( alpha >= beta )     break;
+    }
+
+    return bestScore;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// a field alone in its quadrant is tried first (parity)
+
+template<int Size>
+int EndgameSolver<Size>::last3( const Bits own, const Bits opp, int alpha, const int beta,
+                                const std::array<int, 3>& fields, const bool passed )
+{
+    if( stopped() )
+        return 0;
+
+    std::array<int, 3> order { fields };
+
+    for( int i { 0 }; i < 3; ++i )
+    {
+        int quadrant { 0 };
+
+        while( !( m_Quadrants[quadrant] & Board::square(order[i]) ) )
+            ++quadrant;
+
+        const Bits others { Board::square(order[( i + 1 ) % 3]) | Board::square(order[( i + 2 ) % 3]) };
+
+        if( !( m_Quadrants[quadrant] & others ) )                                   // alone: move it to the front
+        {
+            std::swap(order[0], order[i]);
+            break;
+        }
+    }
+
+    int bestScore { -m_Infinity };
+
+    for( int i { 0 }; i < 3; ++i )
+    {
+        const Bits flips { Board::computeFlips(order[i], own, opp) };
+
+        if( !flips )
+            continue;
+
+        const int score { -last2(opp ^ flips, own | flips | Board::square(order[i]), -beta, -alpha,
+                                 order[( i + 1 ) % 3], order[( i + 2 ) % 3], false) };
+
+        if( score > bestScore )
+        {
+            bestScore = score;
+            if( bestScore > alpha ) alpha = bestScore;
+            if( alpha >= beta )     break;
+        }
+    }
+
+    if( -m_Infinity == bestScore )                                                  // no move: pass - or game over
+        return passed ? finalScore(own, opp) : -last3(opp, own, -beta, -alpha, fields, true);
+
+    return bestScore;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+template<int Size>
+int EndgameSolver<Size>::last2( const Bits own, const Bits opp, int alpha, const int beta, const int field1,
+                                const int field2, const bool passed )
+{
+    ++m_NodeCount;
+
+    int bestScore { -m_Infinity };
+
+    if( const Bits flips { Board::computeFlips(field1, own, opp) } )
+    {
+        bestScore = -last1(opp ^ flips, own | flips | Board::square(field1), field2);
+
+        if( bestScore > alpha ) alpha = bestScore;
+        if( alpha >= beta )     return bestScore;
+    }
+
+    if( const Bits flips { Board::computeFlips(field2, own, opp) } )
+    {
+        const int score { -last1(opp ^ flips, own | flips | Board::square(field2), field1) };
+
+        if( score > bestScore ) bestScore = score;
+    }
+
+    if( -m_Infinity == bestScore )                                                  // no move: pass - or game over
+        return passed ? finalScore(own, opp) : -last2(opp, own, -beta, -alpha, field1, field2, true);
+
+    return bestScore;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// the last move is not made, the flips are just counted: each one changes the difference by 2, plus 1 for the new
+// stone - if the side to move can't play the field, the opponent may
+
+template<int Size>
+int EndgameSolver<Size>::last1( const Bits own, const Bits opp, const int field )
+{
+    ++m_NodeCount;
+
+    const int score { finalScore(own, opp) };
+
+    if( const int flips { BitOps::popCount(Board::computeFlips(field, own, opp)) } )
+        return score + 2 * flips + 1;
+
+    if( const int flips { BitOps::popCount(Board::computeFlips(field, opp, own)) } )
+        return score - 2 * flips - 1;
+
+    return score;                                                                   // nobody can play it
+}
+
+#endif //ENDGAMESOLVER_H
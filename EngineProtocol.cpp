@@ -0,0 +1,353 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "SearchEngine.h"
+
+// =====================================================================================================================
+
+// the engine without a display, driven by a line based text protocol on stdin / stdout - usage: reversi_engine
+//
+// commands, one per line:
+//   isready                            answers "readyok", a running search goes on
+//   newgame [size]                     start position of a board of that size (default: the current one, first 8)
+//   position <fields> <white|black>    set up a position: the fields row by row, 'X' black, 'O' white, '-' empty,
+//                                      and the side to move
+//   move <move>                        make a move of the side to move, e.g. "d3" (coloumn letter, row number), or
+//                                      "pass" if it has no move
+//   go [depth N] [time MS]             search the side to move (default: depth 20, no time limit) in the background,
+//                                      reports "info depth D score S move M nodes N time MS" after every completed
+//                                      iteration and "bestmove M" at the end, M is "pass" without a move
+//   stop                               end the search, "bestmove" follows at once
+//   set threads N | set endgame N      threads of the search, empty fields to solve exactly
+//   board                              print the position and the side to move
+//   quit                               end the engine
+//
+// Anything wrong is answered by "error <reason>". White moves first, as in the game. A score beyond +/- 10000 means
+// the game is decided, the rest is the final disc difference. The files of main.cpp are loaded as well, if present.
+
+namespace
+{
+    /// @brief serves the commands of the protocol
+    class EngineProtocol
+    {
+    public:
+        /// @brief constructor: a new game on the 8x8 board
+        EngineProtocol()
+        { newGame(8); }
+
+        /// @brief destructor: end a running search
+        ~EngineProtocol()
+        { stopSearch(); }
+
+        /*! @brief handle a command
+         *
+         * @param line      command and its arguments
+         * @return          false to quit
+         */
+        bool handle( const std::string& line )
+        {
+            std::istringstream  args { line };
+            std::string         command;
+
+            args >> command;
+
+            if( command.empty() )                   return true;
+            else if( "quit" == command )            return false;
+            else if( "isready" == command )         send("readyok");
+            else if( "stop" == command )            stopSearch();
+            else if( "go" == command )              go(args);
+            else
+            {
+                stopSearch();                                                   // all others change or read the
+                                                                                //      position, wait for the search
+                if( "newgame" == command )          newGame(args);
+                else if( "position" == command )    setPosition(args);
+                else if( "move" == command )        makeMove(args);
+                else if( "set" == command )         setOption(args);
+                else if( "board" == command )       printBoard();
+                else                                send("error unknown command " + command);
+            }
+            return true;
+        }
+
+    private:
+        /*! @brief write a line to stdout, from any thread
+         *
+         * @param text      line without its end
+         */
+        void send( const std::string& text )
+        {
+            std::lock_guard<std::mutex> lock { m_OutMutex };
+
+            std::cout << text << std::endl;
+        }
+
+        /*! @brief start a new game
+         *
+         * @param size      size of the board
+         */
+        void newGame( const int size )
+        {
+            m_Reversi = std::make_unique<Reversi>(size);                     // a copy can't change the size
+            m_ToMove  = Reversi::Stone::WhiteStone;
+            m_Engine  = std::make_unique<SearchEngine>(*m_Reversi);
+
+            m_Engine->setThreads(m_Threads);
+            m_Engine->loadPatterns("reversi-patterns.bin");
+            m_Engine->loadBook("reversi-book-" + std::to_string(size) + ".bin");
+            m_Engine->loadDatabase("reversi-db-" + std::to_string(size) + ".bin");
+        }
+
+        /*! @brief command newgame
+         *
+         * @param args      optional size
+         */
+        void newGame( std::istringstream& args )
+        {
+            int size { m_Reversi->getSize() };
+
+            args >> size;
+
+            if( size < 4 || size > 10 || size % 2 )
+                send("error size has to be 4, 6, 8 or 10");
+            else
+                newGame(size);
+        }
+
+        /*! @brief command position
+         *
+         * @param args      fields and side to move
+         */
+        void setPosition( std::istringstream& args )
+        {
+            const int   size { m_Reversi->getSize() };
+            std::string fields;
+            std::string side;
+
+            args >> fields >> side;
+
+            if( static_cast<int>(fields.size()) != size * size
+                || std::string::npos != fields.find_first_not_of("XO-")
+                || ( "white" != side && "black" != side ) )
+            {
+                send("error expected " + std::to_string(size * size) + " fields of X, O, - and white or black");
+                return;
+            }
+
+            for( int y { 0 }; y < size; ++y )
+            {
+                for( int x { 0 }; x < size; ++x )
+                {
+                    const char field { fields[y * size + x] };
+
+                    m_Reversi->removeStone({ x, y });
+
+                    if( 'X' == field )      m_Reversi->setStone({ x, y }, Reversi::Stone::BlackStone);
+                    else if( 'O' == field ) m_Reversi->setStone({ x, y }, Reversi::Stone::WhiteStone);
+                }
+            }
+            m_ToMove = "white" == side ? Reversi::Stone::WhiteStone : Reversi::Stone::BlackStone;
+        }
+
+        /*! @brief command move
+         *
+         * @param args      move or pass
+         */
+        void makeMove( std::istringstream& args )
+        {
+            const FieldList moves { m_Reversi->getValidMoves(m_ToMove) };
+            std::string     move;
+
+            args >> move;
+
+            if( "pass" == move )
+            {
+                if( 0 != moves.size() )
+                    send("error pass with a valid move");
+                else
+                    m_ToMove = Reversi::otherColor(m_ToMove);
+                return;
+            }
+
+            const int x { move.empty() ? -1 : move[0] - 'a' };
+            const int y { move.size() < 2 ? -1 : std::atoi(move.c_str() + 1) - 1 };
+
+            for( size_t i { 0 }; i < moves.size(); ++i )
+            {
+                const Pos_Vect pos { moves[i].getFieldPosition() };
+
+                if( pos.getX() == x && pos.getY() == y )
+                {
+                    m_Reversi->makeMove(moves[i], m_ToMove);
+                    m_ToMove = Reversi::otherColor(m_ToMove);
+                    return;
+                }
+            }
+            send("error invalid move " + move);
+        }
+
+        /*! @brief command set
+         *
+         * @param args      name and value of the option
+         */
+        void setOption( std::istringstream& args )
+        {
+            std::string name;
+            int         value { -1 };
+
+            args >> name >> value;
+
+            if( "threads" == name && value > 0 )
+            {
+                m_Threads = value;
+                m_Engine->setThreads(value);
+            }
+            else if( "endgame" == name && value >= 0 )
+                m_Engine->setEndgame(value);
+            else
+                send("error unknown option or value " + name);
+        }
+
+        /// @brief command board
+        void printBoard()
+        {
+            const int size { m_Reversi->getSize() };
+
+            for( int y { 0 }; y < size; ++y )
+            {
+                std::string row;
+
+                for( int x { 0 }; x < size; ++x )
+                {
+                    const Reversi::Stone field { m_Reversi->peekField({ x, y }) };
+
+                    row += Reversi::Stone::BlackStone == field ? 'X' : Reversi::Stone::WhiteStone == field ? 'O' : '-';
+                }
+                send(row);
+            }
+            send(Reversi::Stone::WhiteStone == m_ToMove ? "white" : "black");
+        }
+
+        /*! @brief command go: start the search of the side to move
+         *
+         * @param args      limits of the search
+         */
+        void go( std::istringstream& args )
+        {
+            int         depth { m_DefaultDepth };
+            int         timeMs { 0 };
+            std::string limit;
+
+            while( args >> limit )
+            {
+                if( "depth" == limit )          args >> depth;
+                else if( "time" == limit )      args >> timeMs;
+                else
+                {
+                    send("error unknown limit " + limit);
+                    return;
+                }
+            }
+
+            if( depth < 1 || timeMs < 0 )
+            {
+                send("error invalid limit");
+                return;
+            }
+
+            stopSearch();                                                           // one search at a time
+
+            const auto start { std::chrono::steady_clock::now() };
+            const auto elapsedMs = [start]()
+            {
+                return static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                  std::chrono::steady_clock::now() - start).count());
+            };
+
+            m_Engine->setPosition(*m_Reversi);
+            m_Engine->setProgress([this, elapsedMs]( const SearchEngine::MoveInfo& info )
+            {
+                send("info depth " + std::to_string(info.depth) + " score " + std::to_string(info.score)
+                     + " move " + toText(info.pos) + " nodes " + std::to_string(info.nodes)
+                     + " time " + std::to_string(elapsedMs()));
+            });
+
+            m_SearchDone = false;
+            m_Search     = std::thread([this, depth, timeMs, elapsedMs]()
+            {
+                const SearchEngine::MoveInfo info { m_Engine->computeNextMove(m_ToMove, depth, timeMs) };
+
+                if( info.idx >= 0 && 0 == info.depth )                              // book or database, no iteration
+                    send("info depth 0 score " + std::to_string(info.score) + " move " + toText(info.pos)
+                         + " nodes 0 time " + std::to_string(elapsedMs()));
+
+                send("bestmove " + ( info.idx < 0 ? std::string { "pass" } : toText(info.pos) ));
+                m_SearchDone = true;
+            });
+        }
+
+        /*! @brief stop a running search and wait for its end
+         * @details A stop before the computation started is lost when it starts, so stop until it is done.
+         */
+        void stopSearch()
+        {
+            if( !m_Search.joinable() )
+                return;
+
+            while( !m_SearchDone )
+            {
+                m_Engine->stop();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            m_Search.join();
+        }
+
+        /*! @brief get the text of a move
+         *
+         * @param pos       position of the stone
+         * @return          e.g. "d3"
+         */
+        static std::string toText( const Pos_Vect& pos )
+        { return std::string(1, static_cast<char>('a' + pos.getX())) + std::to_string(pos.getY() + 1); }
+
+        static constexpr const int      m_DefaultDepth { 20 };              ///< max. depth without a limit given
+
+        std::unique_ptr<Reversi>        m_Reversi;                          ///< the game
+        Reversi::Stone                  m_ToMove { Reversi::Stone::WhiteStone };    ///< side to move
+        int                             m_Threads { std::max(1, static_cast<int>(
+                                                        std::thread::hardware_concurrency())) };    ///< search threads
+        std::unique_ptr<SearchEngine>   m_Engine;                           ///< engine of the current board size
+        std::thread                     m_Search;                           ///< running search, if joinable
+        std::atomic<bool>               m_SearchDone { true };              ///< the search sent its best move
+        std::mutex                      m_OutMutex;                         ///< one line at a time on stdout
+    };
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    EngineProtocol  protocol;
+    std::string     line;
+
+    std::ios::sync_with_stdio(false);
+
+    while( std::getline(std::cin, line) && protocol.handle(line) )
+        ;
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef EVALWEIGHTS_H
+#define EVALWEIGHTS_H
+
+#include <array>
+#include <algorithm>
+
+#include "Pos_Vect.h"
+
+// =====================================================================================================================
+
+/*! @brief weights of the heuristic evaluation of a position, one set per board size
+ * @details Each field belongs to a class by its distance to the nearest edges: corners are stable once taken, the
+ * X-fields (diagonal next to a corner) and C-fields (on the edge next to a corner) tend to give the corner away, the
+ * other edge fields are hard to flip, the second ring gives access to the edge, the inner fields are neutral. Every
+ * class has a weight per board size, the table of field weights is built from these at compile time. Reversi keeps
+ * the sum of the weights of the stones of each color up to date whenever a stone is set, removed or flipped.
+ *
+ * Besides the fields a position is scored by
+ * - mobility: the number of moves of each side
+ * - potential mobility: empty fields next to the stones of the opponent, candidates for later moves
+ * - parity: the side to move gets the last move if the number of empty fields is odd
+ *
+ * Like the Zobrist keys, the fields are laid out for the largest board, a position is x * 10 + y.
+ */
+class EvalWeights
+{
+public:
+    static constexpr const int m_MaxBoardSize { 10 };                       ///< largest board supported
+
+    /// @brief weights of the terms scored per position
+    struct Terms
+    {
+        int     mobility;                                                   ///< per move more than the opponent
+        int     potential;                                                  ///< per empty field next to opponent
+        int     parity;                                                     ///< for getting the last move
+    };
+
+    /*! @brief get weight of a field
+     *
+     * @param pos       position of the field
+     * @param size      size of the board
+     * @return          weight
+     */
+    static int fieldWeight( const Pos_Vect& pos, const int size )
+    { return m_FieldWeights[sizeIndex(size)][pos.getX() * m_MaxBoardSize + pos.getY()]; }
+
+    /*! @brief get weights of the terms scored per position
+     *
+     * @param size      size of the board
+     * @return          weights
+     */
+    static const Terms& terms( const int size )
+    { return m_Terms[sizeIndex(size)]; }
+
+private:
+    static constexpr const int m_NumSizes { 4 };                            ///< sizes 4, 6, 8 and 10
+
+    /// @brief class of a field by its distance to the edges
+    enum FieldClass { Corner, CField, XField, Edge, Ring, Inner, NumClasses };
+
+    using ClassWeights = std::array<std::array<int, NumClasses>, m_NumSizes>;                 ///< per size and class
+    using FieldWeights = std::array<std::array<int, m_MaxBoardSize * m_MaxBoardSize>, m_NumSizes>; ///< per field
+
+    /*! @brief index of the weights of a board size
+     *
+     * @param size      size of the board
+     * @return          index
+     */
+    static constexpr int sizeIndex( const int size )
+    { return size / 2 - 2; }
+
+    /*! @brief class of a field
+     *
+     * @param x         coloumn
+     * @param y         row
+     * @param size      size of the board
+     * @return          class
+     */
+    static constexpr FieldClass fieldClass( const int x, const int y, const int size )
+    {
+        const int dx { std::min(x, size - 1 - x) };                         // distance to the nearest edge
+        const int dy { std::min(y, size - 1 - y) };
+        const int nearest { std::min(dx, dy) };
+        const int farthest { std::max(dx, dy) };
+
+        if( 0 == farthest )                         return Corner;
+        if( 0 == nearest && 1 == farthest )         return CField;
+        if( 1 == nearest && 1 == farthest )         return XField;
+        if( 0 == nearest )                          return Edge;
+        if( 1 == nearest )                          return Ring;
+        return Inner;
+    }
+
+    /*! @brief build the field weights of all board sizes
+     *
+     * @return          table of weights
+     */
+    static constexpr FieldWeights makeFieldWeights()
+    {
+        FieldWeights weights {};
+
+        for( int s { 0 }; s < m_NumSizes; ++s )
+        {
+            const int size { 4 + 2 * s };
+
+            for( int x { 0 }; x < size; ++x )
+            {
+                for( int y { 0 }; y < size; ++y )
+                {
+                    weights[s][x * m_MaxBoardSize + y] = m_ClassWeights[s][fieldClass(x, y, size)];
+                }
+            }
+        }
+        return weights;
+    }
+
+    //                                                             corner   C    X  edge ring inner
+    static constexpr const ClassWeights m_ClassWeights { { { {     20,     -4,   0,   0,   0,   0 } },    // 4x4
+                                                           { {     20,     -4,  -6,   4,  -1,   1 } },    // 6x6
+                                                           { {     20,     -3,  -7,   8,  -2,   1 } },    // 8x8
+                                                           { {     20,     -3,  -7,   8,  -2,   1 } } } }; // 10x10
+
+    static const FieldWeights           m_FieldWeights;                     ///< weight per size and field
+
+    static constexpr const std::array<Terms, m_NumSizes> m_Terms { { { 6, 2, 3 },       // 4x4
+                                                                     { 6, 2, 3 },       // 6x6
+                                                                     { 5, 2, 3 },       // 8x8
+                                                                     { 5, 2, 2 } } };   // 10x10
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// constant-initialized, the table is computed by the compiler
+inline const EvalWeights::FieldWeights EvalWeights::m_FieldWeights { EvalWeights::makeFieldWeights() };
+
+#endif //EVALWEIGHTS_H
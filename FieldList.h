@@ -6,12 +6,16 @@
 #ifndef FIELDLIST_H
 #define FIELDLIST_H
 
+#include <array>
+#include <algorithm>
+
 #include "FieldValue.h"
 
 // =====================================================================================================================
 
 /*! @brief list of field-values (which is a list as well), used to store the currently possible moves for the game
- * @details Not much surprises here.
+ * @details Not much surprises here. The list is a fixed array big enough for all fields of the largest board, so
+ * like the field-values it never allocates. Copies only copy the used part of the array.
  * It contains
  * - list of field-values
  *
@@ -28,6 +32,34 @@
 
 class FieldList {
 public:
+    static constexpr const int m_MaxFields { 10 * 10 - 4 };                ///< max. moves / empty fields of a board
+
+    using Values = std::array<FieldValue, m_MaxFields>;                     ///< type of the list
+
+    FieldList() = default;
+
+    /*! @brief copy constructor
+     *
+     * @param other     list to copy
+     */
+    FieldList( const FieldList& other )
+    { *this = other; }
+
+    /*! @brief assignment operator
+     *
+     * @param other     list to assign
+     * @return          self-reference
+     */
+    FieldList& operator=( const FieldList& other )
+    {
+        if( this != &other )
+        {
+            m_Size = other.m_Size;
+            std::copy_n(other.m_Values.begin(), m_Size, m_Values.begin());
+        }
+        return *this;
+    }
+
     /*! @brief get index of position with the highest number of possible flips
      *
      * @return      index
@@ -37,7 +69,7 @@ public:
         int ret { -1 };
         int v { -1 };
 
-        for( int idx { 0 }; idx < m_Values.size(); ++idx )
+        for( int idx { 0 }; idx < static_cast<int>(m_Size); ++idx )
         {
             const int curVal { m_Values[idx].getValue() };
 
@@ -53,22 +85,22 @@ public:
      *
      * @return      iterator
      */
-    std::vector<FieldValue>::const_iterator begin() const
+    Values::const_iterator begin() const
     { return m_Values.begin(); }
 
     /*! @brief iterator regarding list of Field-Values
      *
      * @return      iterator
      */
-    std::vector<FieldValue>::const_iterator end() const
-    { return m_Values.end(); }
+    Values::const_iterator end() const
+    { return m_Values.begin() + m_Size; }
 
     /*! @brief get number of positions
      *
      * @return      number of positions
      */
     size_t size() const
-    { return  m_Values.size(); }
+    { return  m_Size; }
 
     /*! @brief index operator
      *
@@ -78,27 +110,42 @@ public:
     FieldValue& operator[]( size_t i )
     { return m_Values[i]; }
 
+    /*! @brief index operator
+     *
+     * @param i     index to access
+     * @return      reference to stored value (list of positions)
+     */
+    const FieldValue& operator[]( size_t i ) const
+    { return m_Values[i]; }
+
     /*! @brief add an element to the list
      *
      * @param elem      element to add
      */
     void push_back( const FieldValue& elem )
-    { m_Values.push_back(elem); }
+    { m_Values[m_Size++] = elem; }
 
     /*! access last element of lisst
      *
      * @return          reference to last element of list
      */
     const FieldValue& back() const
-    { return m_Values.back(); }
+    { return m_Values[m_Size - 1]; }
 
     /*! @brief remove last element from list
      *
      */
     void pop_back()
-    { m_Values.pop_back(); }
+    { --m_Size; }
+
+    /*! @brief remove all elements
+     *
+     */
+    void clear()
+    { m_Size = 0; }
 private:
-    std::vector<FieldValue>     m_Values{};                     ///< the list itself
+    size_t                      m_Size { 0 };                   ///< number of elements in use
+    Values                      m_Values;                       ///< the list itself
 };
 
 #endif //FIELDLIST_H
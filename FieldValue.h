@@ -6,7 +6,8 @@
 #ifndef FIELDVALUE_H
 #define FIELDVALUE_H
 
-#include <vector>
+#include <array>
+#include <cstdint>
 #include <cstddef>
 
 #include "Pos_Vect.h"
@@ -17,11 +18,13 @@
  * will get flipped if a stone of a certain color is placed on that field.
  *
  * @details For easier handling, we do not only store the number of flippable stones here, but the complete list
- * of positions of those stones.
+ * of positions of those stones. The list is a small array inside the object, each position packed into one byte,
+ * so creating and copying field-values never touches the heap. A move can flip at most N - 2 stones along each of
+ * the four lines through its field, which gives the capacity for the largest (10x10) board.
  *
  * This class contains
  * - position of the field
- * - a vector of positions of fields that can be "flipped"
+ * - an array of positions of fields that can be "flipped"
  *
  * It implements:
  * - getter/setter for the position
@@ -33,6 +36,50 @@
 
 class FieldValue {
 public:
+    static constexpr const int m_MaxFlips { 4 * ( 10 - 2 ) };             ///< max. flips of a single move
+
+    /*! @brief iterator regarding the positions of the flips
+     *
+     */
+    class Iterator
+    {
+    public:
+        /*! @brief constructor
+         *
+         * @param packed    pointer to packed position
+         */
+        explicit Iterator( const uint8_t* packed )
+            : m_Packed { packed }
+        {}
+
+        /*! @brief de-refencing
+         *
+         * @return      position of the flip
+         */
+        Pos_Vect operator*() const
+        { return unpack(*m_Packed); }
+
+        /*! @brief pre-increment
+         *
+         * @return      self-reference
+         */
+        Iterator& operator++()
+        { ++m_Packed; return *this; }
+
+        /*! @brief comparison
+         *
+         * @param it    iterator
+         * @return      true if not equal
+         */
+        bool operator!=( const Iterator& it ) const
+        { return m_Packed != it.m_Packed; }
+
+    private:
+        const uint8_t*  m_Packed;                                           ///< current packed position
+    };
+
+    FieldValue() = default;
+
     /*! @brief constructor
      *
      * @param position          position of the field on the board
@@ -60,34 +107,34 @@ public:
      * @return          value
      */
     int getValue() const
-    { return static_cast<int>(m_Flips.size()); }
+    { return m_NumFlips; }
 
     /*! @brief add the position of a possible flip
      *
      * @param pos       position of a "flipable" stone
      */
     void addValuePosition( const Pos_Vect& pos )
-    { m_Flips.push_back(pos); }
+    { m_Flips[m_NumFlips++] = pack(pos); }
 
     /*! @brief iterator to support range-based access
      *
      * @return          iterator regarding the list of values
      */
-    std::vector<Pos_Vect>::iterator begin()
-    { return { m_Flips.begin() }; }
+    Iterator begin() const
+    { return Iterator { m_Flips.data() }; }
 
     /*! @brief iterator to support range-based access
      *
      * @return          iterator regarding the list of values
      */
-    std::vector<Pos_Vect>::iterator end()
-    { return { m_Flips.end() }; }
+    Iterator end() const
+    { return Iterator { m_Flips.data() + m_NumFlips }; }
 
     /*! @brief remove all possible flips, setting the value to 0 (invalid move)
      *
      */
     void delPostions()
-    { m_Flips.clear(); }
+    { m_NumFlips = 0; }
 
     /*! @brief add another field / value to this one, effectively raising the "score" - used to combine analysis of different directions
      *
@@ -96,15 +143,32 @@ public:
      */
     FieldValue& operator +=( const FieldValue& v )
     {
-        for( const auto &p : v.m_Flips )
+        for( int i { 0 }; i < v.m_NumFlips; ++i )
         {
-            addValuePosition(p);
+            m_Flips[m_NumFlips++] = v.m_Flips[i];
         }
 		return *this;
     }
 private:
-    Pos_Vect                m_position { 0, 0 };                    ///< position of stone / field
-    std::vector<Pos_Vect>   m_Flips {};                             ///< list of stones that would be flipped
+    /*! @brief pack a position into a byte, 4 bits per coordinate
+     *
+     * @param pos       position
+     * @return          packed position
+     */
+    static uint8_t pack( const Pos_Vect& pos )
+    { return static_cast<uint8_t>(( pos.getX() << 4 ) | pos.getY()); }
+
+    /*! @brief unpack a position
+     *
+     * @param packed    packed position
+     * @return          position
+     */
+    static Pos_Vect unpack( const uint8_t packed )
+    { return { packed >> 4, packed & 0x0f }; }
+
+    Pos_Vect                            m_position { 0, 0 };            ///< position of stone / field
+    uint8_t                             m_NumFlips { 0 };               ///< number of stones that would be flipped
+    std::array<uint8_t, m_MaxFlips>     m_Flips;                        ///< packed positions of those stones
 };
 
 #endif //FIELDVALUE_H
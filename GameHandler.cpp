@@ -10,6 +10,7 @@
 GameHandler::GameHandler( CursesGrid& gridView, Reversi& reversi )
     : m_gridView { gridView }
     , m_reversi { reversi }
+    , m_engine { reversi }
 {
     // initialize display regarding initial state of the game board
     for( auto i = m_reversi.begin(); i != m_reversi.end(); ++i )
@@ -24,6 +25,13 @@ GameHandler::GameHandler( CursesGrid& gridView, Reversi& reversi )
 
 // ---------------------------------------------------------------------------------------------------------------------
 
+GameHandler::~GameHandler()
+{
+    stopPonder();                                                                   // it has no time limit
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
 bool GameHandler::ended() const
 {
     return m_reversi.gameOver();
@@ -121,6 +129,9 @@ void GameHandler::makeMove( const Reversi::Stone stone, const bool view )
     FieldValue  storedMove { m_validMoves[m_movesIdx] };
     storedMove.setFieldPosition(m_curPos);
     m_UndoList.push_back(storedMove);
+
+    if( m_reversi.getHash() != m_ponderHash )                                       // not the expected move: free the
+        stopPonder();                                                               //      cores at once
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -129,6 +140,8 @@ bool GameHandler::undoMove( const bool view )
 {
     if( !m_UndoList.size() ) return false;
 
+    stopPonder();                                                                   // the position goes back
+
     if( view ) m_gridView.unmarkCells(m_validMoves);                                // unmark since decision is made
 
     FieldValue undo = m_UndoList.back();
@@ -162,142 +175,80 @@ int GameHandler::stone2Char( const Reversi::Stone stone )
     case Reversi::Stone::BlackStone : return ' ';
     case Reversi::Stone::NoStone    : return ACS_BULLET | COLOR_PAIR(1);
     case Reversi::Stone::WhiteStone : return ' ' | A_REVERSE;
+    case Reversi::Stone::OffBoard   : return ' ';
     }
 }
 
-// ---------------------------------------------------------------------------------------------------------------------
-// ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 
-int GameHandler::getScore( const Reversi::Stone stone ) const
-{
-    return Reversi::Stone::WhiteStone == stone
-           ? m_reversi.getWhiteNum() - m_reversi.getBlackNum()
-           : m_reversi.getBlackNum() - m_reversi.getWhiteNum();
-}
+// the search runs on a snapshot of the game, so the board shown is not touched during the computation - if the
+// player made the expected move, the pondering becomes the computation: it already runs since the player's turn began
 
-// ---------------------------------------------------------------------------------------------------------------------
-
-// currently limited by depth but should rather be limited by time
-
-GameHandler::MoveInfo GameHandler::computeNextMove( const Reversi::Stone stone, const int depth )
+GameHandler::MoveInfo GameHandler::computeNextMove( const Reversi::Stone stone, const int depth, const int timeLimitMs )
 {
-    MoveInfo    ret { {-1, -1}, -1 };
-    int         alpha { -m_reversi.getBoardSize() };
-    const int   beta { m_reversi.getBoardSize() };
-
-    m_stopCalculation = false;                                                      // assume to keep working
-
-    prepareNextMove(stone, false);                                                  // prepare game info regarding move
-
-    const int validMoves { static_cast<int>(m_validMoves.size()) };                 // get number of possible moves
-    int idx { 0 };
-
-    while( idx < validMoves )                                                       // iterate over them
+    if( m_ponder.valid() && stone == m_ponderStone && m_reversi.getHash() == m_ponderHash )
     {
-        if( m_stopCalculation ) break;
+        if( timeLimitMs > 0 && std::future_status::ready != m_ponder.wait_for(std::chrono::milliseconds(timeLimitMs)) )
+            while( std::future_status::ready != m_ponder.wait_for(std::chrono::milliseconds(1)) )
+                m_engine.stop();                                                    // deepest completed iteration
 
-        makeMove(stone, false);                                                     // make this move
-
-        const int score { minScore(Reversi::otherColor(stone), depth - 1, alpha, beta) };  // calculate min score
-
-        undoMove(false);                                                            // undo the move
-        prepareNextMove(stone, false);                                              // prepare for the next move
-
-        if( score > alpha )
-            alpha = score;
+        return m_ponder.get();
+    }
 
-        ret.pos = m_validMoves[idx].getFieldPosition();
-        ret.idx = idx;
+    stopPonder();
 
-        if( m_reversi.gameOver() )
-            break;
+    m_engine.setPosition(m_reversi);
 
-        ++idx;
-    }
-
-    return ret;
+    return m_engine.computeNextMove(stone, depth, timeLimitMs);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// heuristic https://kartikkukreja.wordpress.com/2013/03/30/heuristic-function-for-reversiothello/
 
-int GameHandler::maxScore( const Reversi::Stone stone, const int depth, int alpha, const int beta )
+void GameHandler::startPonder( const Reversi::Stone stone, const int depth )
 {
-    if( m_reversi.gameOver() )
-        return getScore(stone);
+    const Reversi::Stone    other { Reversi::otherColor(stone) };
+    Reversi                 position { m_reversi };
+    const FieldList         replies { position.getValidMoves(other) };
+    Pos_Vect                expected { -1, -1 };
 
-    if( depth <= 0 )
-        return getScore(stone);                                                     // should rather be heuristic
+    stopPonder();
+    m_engine.setPosition(position);
 
-    prepareNextMove(stone, false);
+    if( 0 == replies.size() )                                                       // the player has to pass
+        return;
 
-    const int   validMoves { static_cast<int>(m_validMoves.size()) };
-    int         idx { 0 };
-    int         bestScore { -m_reversi.getBoardSize() };
+    if( !m_engine.getHashMove(other, expected) )                                    // e.g. after a book move
+        expected = m_engine.computeNextMove(other, m_guessDepth).pos;
 
-    while( idx < validMoves )
+    for( size_t i { 0 }; i < replies.size(); ++i )
     {
-        if( m_stopCalculation ) break;
-
-        makeMove(stone, false);
-
-        const int score = minScore(Reversi::otherColor(stone), depth - 1, alpha, beta);
-
-        undoMove(false);
-        prepareNextMove(stone, false);
-
-        bestScore = std::max(bestScore, score);
-
-        alpha = std::max(alpha, bestScore);
-
-        if( alpha >= beta )
-            break;
-
-        selectNextValidMove(stone, false);
-
-        ++idx;
+        const Pos_Vect pos { replies[i].getFieldPosition() };
+
+        if( pos.getX() == expected.getX() && pos.getY() == expected.getY() )
+        {
+            position.makeMove(replies[i], other);
+
+            m_ponderStone = stone;
+            m_ponderHash  = position.getHash();
+            m_engine.setPosition(position);
+            m_ponder      = std::async(std::launch::async,
+                                       [this, stone, depth]() { return m_engine.computeNextMove(stone, depth); });
+            return;
+        }
     }
-    return bestScore;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-int GameHandler::minScore( const Reversi::Stone stone, const int depth, const int alpha, int beta )
-{
-    if( m_reversi.gameOver() )
-        return getScore(stone);
-
-    if( depth <= 0 )
-        return getScore(stone);
+// a stop before the computation started is lost when it starts, so stop until it is done
 
-    prepareNextMove(stone, false);
-
-    const int   validMoves { static_cast<int>(m_validMoves.size()) };
-    int         idx { 0 };
-    int         bestScore { m_reversi.getBoardSize() };
-
-    while( idx < validMoves )
-    {
-        if( m_stopCalculation ) break;
-
-        makeMove(stone, false);
-
-        const int score = maxScore(Reversi::otherColor(stone), depth - 1, alpha, beta);
-
-        undoMove(false);
-        prepareNextMove(stone, false);
-
-        bestScore = std::min(bestScore, score);
-
-        beta = std::min(beta, bestScore);
-
-        if( alpha >= beta )
-            break;
+void GameHandler::stopPonder()
+{
+    if( !m_ponder.valid() )
+        return;
 
-        selectNextValidMove(stone, false);
+    while( std::future_status::ready != m_ponder.wait_for(std::chrono::milliseconds(1)) )
+        m_engine.stop();
 
-        ++idx;
-    }
-    return bestScore;
+    m_ponder.get();
 }
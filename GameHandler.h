@@ -6,14 +6,14 @@
 #ifndef GAMEHANDLER_H
 #define GAMEHANDLER_H
 
-#include <atomic>
-#include <mutex>
-#include <condition_variable>
+#include <future>
+
 #include "Pos_Vect.h"
 #include "FieldValue.h"
 #include "CursesGrid.h"
 
 #include "Reversi.h"
+#include "SearchEngine.h"
 
 // =====================================================================================================================
 
@@ -28,6 +28,7 @@
  * - the current position regarding a move-selection
  * - a lsit of valid moves for a time
  * - an undo list, to undo all done moves
+ * - the search engine used to compute moves
  *
  * it implements:
  * - a check if the game has ended
@@ -38,18 +39,19 @@
  * - undo a move
  * - get the possible flips for a selected move
  * - compute the best next move
- * The computation of the best next move is done via a min-max algorithm that computes all moves down to a
- * certain depth. This is done via an async thread that may be forced to stop by a user input.
+ * - pondering: computing the next move while the player thinks about the own one
+ * The computation of the best next move is done by the SearchEngine on a snapshot of the game, via an async thread
+ * that may be forced to stop by a user input. Neither the board nor the list of valid moves shown to the player are
+ * touched by the computation.
+ *
+ * While the player thinks, the engine ponders: it expects the reply its last computation found best and computes its
+ * answer to it in the background. If the player makes that move, the pondering goes on as the computation of the move,
+ * if not, it is stopped at once - the transposition table keeps what was found either way.
  */
 class GameHandler
 {
 public:
-    /// @brief info to be returned by the next computed move
-    struct MoveInfo {
-        Pos_Vect pos;                                                               ///< position for stone
-        int      idx;                                                               ///< index of move in the list of
-                                                                                    ///      valid moves
-    };
+    using MoveInfo = SearchEngine::MoveInfo;                                        ///< info of a computed move
 
     /*! @brief constructor
      *
@@ -58,6 +60,11 @@ public:
      */
     GameHandler( CursesGrid&  gridView,  Reversi& reversi );
 
+    /*! @brief destructor, stops pondering
+     *
+     */
+    ~GameHandler();
+
     /*! @brief game ended?
      *
      * @return      true if game over
@@ -118,65 +125,88 @@ public:
      */
     int getPossibleFlips();
 
-    /*! @brief compute a "good" next move by analysing all possibilities down to a certain depth, does an alpha-beta search
+    /*! @brief compute a "good" next move by analysing all possibilities, does an alpha-beta search with iterative
+     * deepening until the max. depth is reached or the time is up
      *
-     * @param stone     stone to place
-     * @param depth     calculation depth - analyzing all moves up to that depth
-     * @return          move-info : position of stone and index of that move in the list of possible moves
+     * @param stone         stone to place
+     * @param depth         max. calculation depth - analyzing all moves up to that depth
+     * @param timeLimitMs   time budget in milli-seconds, 0 for no limit
+     * @return              move-info : position of stone and index of that move in the list of possible moves
      */
-    MoveInfo computeNextMove( const Reversi::Stone stone, const int depth );
+    MoveInfo computeNextMove( const Reversi::Stone stone, const int depth, const int timeLimitMs = 0 );
+
+    /*! @brief start pondering: compute the answer to the expected reply of the player in the background, a
+     * pondering started before is stopped
+     *
+     * @param stone         stone of the engine, the player has to move the other one
+     * @param depth         max. depth of the answer
+     */
+    void startPonder( const Reversi::Stone stone, const int depth );
+
+    /*! @brief stop pondering and wait for it to end, nothing happens if there is none
+     *
+     */
+    void stopPonder();
 
     /*! @brief cancel the calculation of the next move
      *
      */
     void stop()
-    { m_stopCalculation = true; }
+    { m_engine.stop(); }
 
-protected:
-    /*! qbrief get char to display for certain stone
+    /*! @brief set the number of threads computing the next move
      *
-     * @param stone     stone to show
-     * @return          character tp display
+     * @param numThreads    number of threads, at least 1
      */
-    static int stone2Char( const Reversi::Stone stone );
+    void setThreads( const int numThreads )
+    { m_engine.setThreads(numThreads); }
 
-    /*! @brief get current score of the game regarding a stone
+    /*! @brief load the weights of the pattern evaluation of 8x8 positions
      *
-     * @param stone     stone to check
-     * @return          score
+     * @param path          name of the file of weights
+     * @return              false if the file is missing or invalid, the simple evaluation is used then
      */
-    int      getScore( const Reversi::Stone stone ) const;
+    bool loadPatterns( const std::string& path )
+    { return m_engine.loadPatterns(path); }
 
-    /*! @brief get max score
+    /*! @brief load an opening book for the size of the board
      *
-     * @param stone     stone to check
-     * @param depth     max depth regarding analyzation
-     * @param alpha     player-score regarding stone
-     * @param beta      score regarding opponent
-     * @return
+     * @param path          name of the book
+     * @return              false if the file is missing or not a book for this board, moves are searched then
      */
-    int      maxScore( const Reversi::Stone stone, const int depth, int alpha, const int beta );
+    bool loadBook( const std::string& path )
+    { return m_engine.loadBook(path); }
 
-    /*! @brief get min score
+    /*! @brief load a database of exact scores for a small board
      *
-     * @param stone     stone to check
-     * @param depth     max depth regarding analyzation
-     * @param alpha     player-score regarding stone
-     * @param beta      score regarding opponent
-     * @return
+     * @param path          name of the database
+     * @return              false if the file is missing or not a database for this board, moves are searched then
      */
-    int      minScore( const Reversi::Stone stone, const int depth, const int alpha, int beta );
+    bool loadDatabase( const std::string& path )
+    { return m_engine.loadDatabase(path); }
 
-private:
+protected:
+    /*! qbrief get char to display for certain stone
+     *
+     * @param stone     stone to show
+     * @return          character tp display
+     */
+    static int stone2Char( const Reversi::Stone stone );
 
+private:
     CursesGrid&         m_gridView;                                     ///< display
     Reversi&            m_reversi;                                      ///< gaming engine
     Pos_Vect            m_curPos{ 0, 0 };                               ///< current position
     int                 m_movesIdx { 0 };                               ///< current index regarding valid moves
     FieldList           m_validMoves {};                                ///< list of valid moves
     FieldList           m_UndoList {};                                  ///< to undo the moves
-
-    std::atomic<bool>   m_stopCalculation { false };                    ///< stop-flag
+    SearchEngine        m_engine;                                       ///< computes the moves on a snapshot
+    std::future<MoveInfo> m_ponder;                                     ///< answer being pondered, if valid
+    Reversi::Stone      m_ponderStone { Reversi::Stone::NoStone };      ///< stone of the pondered answer
+    uint64_t            m_ponderHash { 0 };                             ///< hash of the stones after the expected
+                                                                        ///      reply
+    static constexpr const int m_guessDepth { 4 };                      ///< depth to find the expected reply if
+                                                                        ///      the table has none
 };
 
 #endif //GAMEHANDLER_H
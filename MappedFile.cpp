@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <cstdio>
+
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =====================================================================================================================
+
+#if defined(_WIN32)
+
+bool MappedFile::open( const std::string& path )
+{
+    close();
+
+    HANDLE file { CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr) };
+
+    if( INVALID_HANDLE_VALUE == file )
+        return false;
+
+    LARGE_INTEGER size {};
+
+    if( !GetFileSizeEx(file, &size) || 0 == size.QuadPart )
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping { CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+    void*  data { mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr };
+
+    if( !data )
+    {
+        if( mapping ) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_File    = file;
+    m_Mapping = mapping;
+    m_Data    = static_cast<const uint8_t*>(data);
+    m_Size    = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void MappedFile::close()
+{
+    if( m_Data )    UnmapViewOfFile(m_Data);
+    if( m_Mapping ) CloseHandle(m_Mapping);
+    if( m_File )    CloseHandle(m_File);
+
+    m_Data    = nullptr;
+    m_Size    = 0;
+    m_Mapping = nullptr;
+    m_File    = nullptr;
+}
+
+#else
+
+bool MappedFile::open( const std::string& path )
+{
+    close();
+
+    const int file { ::open(path.c_str(), O_RDONLY) };
+
+    if( file < 0 )
+        return false;
+
+    struct stat info {};
+
+    if( fstat(file, &info) != 0 || 0 == info.st_size )
+    {
+        ::close(file);
+        return false;
+    }
+
+    void* data { mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0) };
+
+    ::close(file);                                                                  // the mapping stays valid
+
+    if( MAP_FAILED == data )
+        return false;
+
+    m_Data = static_cast<const uint8_t*>(data);
+    m_Size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void MappedFile::close()
+{
+    if( m_Data )
+        munmap(const_cast<uint8_t*>(m_Data), m_Size);
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool MappedFile::writeReplacing( const std::string& path, std::initializer_list<Block> blocks )
+{
+    const std::string   tempPath { path + ".tmp" };
+    FILE*               file { std::fopen(tempPath.c_str(), "wb") };
+
+    if( !file )
+        return false;
+
+    bool written { true };
+
+    for( const auto& block : blocks )
+        written = written && ( 0 == block.size || 1 == std::fwrite(block.data, block.size, 1, file) );
+
+    if( 0 != std::fclose(file) || !written )
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+#if defined(_WIN32)
+    if( !MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) )    // rename doesn't replace
+#else
+    if( 0 != std::rename(tempPath.c_str(), path.c_str()) )                          // atomic: the old file or the new
+#endif
+    {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+
+// =====================================================================================================================
+
+/*! @brief read-only memory mapping of a whole file
+ * @details Opening is instant whatever the size of the file, pages are read on first access. All processes mapping the
+ * same file share one copy of it in the page cache. Uses mmap on Linux and a file mapping on Windows.
+ *
+ * It contains
+ * - the address and size of the mapping
+ * - the handles needed to release it
+ *
+ * It implements
+ * - mapping a file, releasing the mapping
+ * - mapping a file starting with a header of the common layout and checking it
+ * - access to the mapped bytes
+ * - writing a file as a whole, replacing the old one
+ *
+ * The files of the engine (book, database, pattern weights) start with a header of the same layout: a magic of 4
+ * characters, the version of the format and the board size as uint32_t, followed by their own fields.
+ */
+class MappedFile
+{
+public:
+    /// @brief a piece of a file to write
+    struct Block
+    {
+        const void*     data;                                               ///< first byte
+        size_t          size;                                               ///< number of bytes
+    };
+
+    MappedFile() = default;
+
+    /*! @brief destructor, releases the mapping
+     *
+     */
+    ~MappedFile()
+    { close(); }
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    /*! @brief map a file, a previous mapping is released
+     *
+     * @param path      name of the file
+     * @return          false if the file doesn't exist, is empty or can't be mapped
+     */
+    bool open( const std::string& path );
+
+    /*! @brief map a file and check its header, a previous mapping is released
+     *
+     * @tparam Header   header of the format, starting with magic, version and boardSize
+     * @param path      name of the file
+     * @param magic     expected magic, 4 characters
+     * @param version   expected version of the format
+     * @param boardSize expected size of the board
+     * @param header    gets the header of the file
+     * @return          false if the file can't be mapped, is too short or the header doesn't match - nothing is
+     *                  mapped then
+     */
+    template<typename Header>
+    bool openChecked( const std::string& path, const char* magic, const uint32_t version, const int boardSize,
+                      Header& header )
+    {
+        if( !open(path) )
+            return false;
+
+        if( m_Size < sizeof(header) )
+        {
+            close();
+            return false;
+        }
+
+        std::memcpy(&header, m_Data, sizeof(header));
+
+        if( 0 != std::memcmp(header.magic, magic, sizeof(header.magic))
+            || version != header.version || boardSize != static_cast<int>(header.boardSize) )
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /*! @brief release the mapping
+     *
+     */
+    void close();
+
+    /*! @brief write a file as a whole: the blocks go to a temporary file first, which then replaces the file
+     * @details Processes still mapping the old file keep it, new ones get the new file - there is no moment without
+     * one. Windows can't replace a file that is mapped, writing fails then.
+     *
+     * @param path      name of the file
+     * @param blocks    contents, in order - e.g. the header and the entries
+     * @return          false if the file can't be written
+     */
+    static bool writeReplacing( const std::string& path, std::initializer_list<Block> blocks );
+
+    /*! @brief check if a file is mapped
+     *
+     * @return          true if mapped
+     */
+    bool isOpen() const
+    { return nullptr != m_Data; }
+
+    /*! @brief get the mapped bytes
+     *
+     * @return          start of the file, nullptr if none is mapped
+     */
+    const uint8_t* data() const
+    { return m_Data; }
+
+    /*! @brief get the size of the file
+     *
+     * @return          number of bytes
+     */
+    size_t size() const
+    { return m_Size; }
+
+private:
+    const uint8_t*  m_Data { nullptr };                                     ///< start of the mapping
+    size_t          m_Size { 0 };                                           ///< size of the mapping
+#if defined(_WIN32)
+    void*           m_File { nullptr };                                     ///< handle of the file
+    void*           m_Mapping { nullptr };                                  ///< handle of the mapping
+#endif
+};
+
+#endif //MAPPEDFILE_H
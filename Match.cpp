@@ -0,0 +1,532 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SearchEngine.h"
+#include "TestPositions.h"
+
+// =====================================================================================================================
+
+// play two engine settings against each other - usage: reversi_match [options] <engineA> <engineB>
+//
+// an engine is given as a list of settings separated by commas, e.g. "depth=8,time=100,patterns=weights.bin":
+//   depth=N        max. depth of a move (default 8)           time=MS        time budget of a move (default 0: none)
+//   hash=MB        size of the transposition table (16)       endgame=N      empty fields to solve exactly (16)
+//   patterns=PATH  weights of the pattern evaluation          algo=pvs|mtdf  search of the root (pvs)
+//
+// options:
+//   -g N           number of openings, each is played twice with swapped colors (default 500)
+//   -s N           size of the board (8)
+//   -p N           plies of a random opening (8)
+//   -o PATH        take the openings from a file of games instead, as read by book_builder, first plies of each line
+//   -j N           games played at the same time (default: number of cores), each engine searches with one thread
+//   -sprt E0 E1    stop as soon as a sequential probability ratio test decides between an Elo difference of E0 and
+//                  one of E1, alpha = beta = 0.05
+//
+// All games use SearchEngine::computeNextMove, the same as the game does. Results are from the view of engine A.
+
+namespace
+{
+    /// @brief settings of an engine
+    struct EngineSpec
+    {
+        int                         depth { 8 };                            ///< max. depth of a move
+        int                         timeMs { 0 };                           ///< time budget of a move, 0: none
+        size_t                      hashMB { 16 };                          ///< size of the transposition table
+        int                         endgame { SearchEngine::m_DefaultEndgameEmpties };  ///< empties to solve
+        std::string                 patterns;                               ///< file of weights, if any
+        SearchEngine::Algorithm     algorithm { SearchEngine::Algorithm::PVS };     ///< search of the root
+    };
+
+    /// @brief results of the games played so far, from the view of engine A
+    struct Results
+    {
+        int         wins { 0 };                                             ///< games won by A
+        int         draws { 0 };                                            ///< draws
+        int         losses { 0 };                                           ///< games lost by A
+        uint64_t    nodes[2] { 0, 0 };                                      ///< positions searched per engine
+        double      seconds[2] { 0.0, 0.0 };                                ///< time searched per engine
+
+        /*! @brief get the number of games
+         *
+         * @return      games
+         */
+        int games() const
+        { return wins + draws + losses; }
+
+        /*! @brief get the mean score of a game: 1 for a win, 0.5 for a draw
+         *
+         * @return      score
+         */
+        double score() const
+        { return ( wins + 0.5 * draws ) / std::max(games(), 1); }
+
+        /*! @brief get the variance of the score of a game
+         *
+         * @return      variance
+         */
+        double variance() const
+        {
+            const double s { score() };
+
+            return ( wins * ( 1.0 - s ) * ( 1.0 - s ) + draws * ( 0.5 - s ) * ( 0.5 - s ) + losses * s * s )
+                   / std::max(games(), 1);
+        }
+    };
+
+    /*! @brief map a mean score to an Elo difference
+     *
+     * @param score     mean score, 0 .. 1
+     * @return          Elo difference
+     */
+    double toElo( const double score )
+    {
+        const double s { std::min(std::max(score, 1e-6), 1.0 - 1e-6) };
+
+        return -400.0 * std::log10(1.0 / s - 1.0);
+    }
+
+    /*! @brief map an Elo difference to the mean score it gives
+     *
+     * @param elo       Elo difference
+     * @return          mean score
+     */
+    double toScore( const double elo )
+    { return 1.0 / ( 1.0 + std::pow(10.0, -elo / 400.0) ); }
+
+    /*! @brief log likelihood ratio of the hypothesis E1 against E0, normal approximation of the results
+     * @details Half a win, draw and loss are added, so the variance is never 0 - this keeps the first games from
+     * deciding the test.
+     *
+     * @param results   games played
+     * @param elo0      Elo difference of H0
+     * @param elo1      Elo difference of H1
+     * @return          ratio
+     */
+    double logLikelihoodRatio( const Results& results, const double elo0, const double elo1 )
+    {
+        const double wins { results.wins + 0.5 };
+        const double draws { results.draws + 0.5 };
+        const double losses { results.losses + 0.5 };
+        const double games { wins + draws + losses };
+        const double score { ( wins + 0.5 * draws ) / games };
+        const double variance { ( wins * ( 1.0 - score ) * ( 1.0 - score ) + draws * ( 0.5 - score ) * ( 0.5 - score )
+                                  + losses * score * score ) / games };
+        const double s0 { toScore(elo0) };
+        const double s1 { toScore(elo1) };
+
+        return games * ( s1 - s0 ) * ( 2.0 * score - s0 - s1 ) / ( 2.0 * variance );
+    }
+
+    /*! @brief parse the settings of an engine
+     *
+     * @param text      settings separated by commas
+     * @param spec      settings to change
+     * @return          false if a setting is unknown
+     */
+    bool parseSpec( const std::string& text, EngineSpec& spec )
+    {
+        std::istringstream  settings { text };
+        std::string         setting;
+
+        while( std::getline(settings, setting, ',') )
+        {
+            const size_t        equal { setting.find('=') };
+            const std::string   key { setting.substr(0, equal) };
+            const std::string   value { std::string::npos == equal ? "" : setting.substr(equal + 1) };
+
+            if( "depth" == key )            spec.depth     = std::atoi(value.c_str());
+            else if( "time" == key )        spec.timeMs    = std::atoi(value.c_str());
+            else if( "hash" == key )        spec.hashMB    = static_cast<size_t>(std::atoi(value.c_str()));
+            else if( "endgame" == key )     spec.endgame   = std::atoi(value.c_str());
+            else if( "patterns" == key )    spec.patterns  = value;
+            else if( "algo" == key && ( "pvs" == value || "mtdf" == value ) )
+                spec.algorithm = "pvs" == value ? SearchEngine::Algorithm::PVS : SearchEngine::Algorithm::MTDf;
+            else
+                return false;
+        }
+        return spec.depth > 0;
+    }
+
+    /*! @brief read the openings from a file of games, see BookBuilder
+     *
+     * @param path      name of the file
+     * @param size      size of the board
+     * @param plies     moves to take from each game
+     * @param openings  openings read, moves as positions
+     * @return          false if the file can't be read
+     */
+    bool readOpenings( const std::string& path, const int size, const int plies,
+                       std::vector<std::vector<Pos_Vect>>& openings )
+    {
+        std::ifstream   games { path };
+        std::string     line;
+
+        if( !games )
+            return false;
+
+        while( std::getline(games, line) )
+        {
+            if( line.empty() || '#' == line[0] )
+                continue;
+
+            std::istringstream      moves { line };
+            std::string             token;
+            std::vector<Pos_Vect>   opening;
+
+            while( static_cast<int>(opening.size()) < plies && moves >> token )
+            {
+                const int row { std::atoi(token.c_str() + 1) };
+
+                if( token.size() < 2 || token[0] < 'a' || token[0] >= 'a' + size || row < 1 || row > size )
+                    break;
+
+                opening.push_back({ token[0] - 'a', row - 1 });
+            }
+
+            if( !opening.empty() )
+                openings.push_back(opening);
+        }
+        return !openings.empty();
+    }
+
+    /// @brief plays the games of a match
+    class Match
+    {
+    public:
+        /*! @brief constructor
+         *
+         * @param specs     settings of engine A and B
+         * @param size      size of the board
+         * @param plies     plies of a random opening
+         * @param openings  openings to play, random ones if empty
+         */
+        Match( const EngineSpec (&specs)[2], const int size, const int plies,
+               const std::vector<std::vector<Pos_Vect>>& openings )
+            : m_Specs { specs[0], specs[1] }
+            , m_Size { size }
+            , m_Plies { plies }
+            , m_Openings { openings }
+        {}
+
+        /*! @brief enable the sequential probability ratio test
+         *
+         * @param elo0      Elo difference of H0
+         * @param elo1      Elo difference of H1
+         */
+        void setSprt( const double elo0, const double elo1 )
+        {
+            m_Sprt = true;
+            m_Elo0 = elo0;
+            m_Elo1 = elo1;
+        }
+
+        /*! @brief play the match, each opening twice with swapped colors
+         *
+         * @param numOpenings   number of openings
+         * @param numThreads    games played at the same time
+         * @return              results
+         */
+        Results run( const int numOpenings, const int numThreads )
+        {
+            std::vector<std::thread> workers;
+
+            for( int i { 0 }; i < numThreads; ++i )
+                workers.emplace_back([this, numOpenings]() { play(numOpenings); });
+
+            for( auto& worker : workers )
+                worker.join();
+
+            return m_Results;
+        }
+
+        /*! @brief get the verdict of the sequential probability ratio test
+         *
+         * @return      text, empty if the test is off
+         */
+        std::string sprtVerdict() const
+        {
+            if( !m_Sprt )
+                return {};
+
+            const double llr { logLikelihoodRatio(m_Results, m_Elo0, m_Elo1) };
+
+            return llr >= m_UpperBound ? "H1 accepted" : llr <= m_LowerBound ? "H0 accepted" : "inconclusive";
+        }
+
+    private:
+        /*! @brief worker: take the next opening and play both of its games until all are taken or the test decided
+         *
+         * @param numOpenings   number of openings
+         */
+        void play( const int numOpenings )
+        {
+            SearchEngine engines[2] { SearchEngine { Reversi { m_Size }, m_Specs[0].hashMB },
+                                      SearchEngine { Reversi { m_Size }, m_Specs[1].hashMB } };
+
+            for( int e { 0 }; e < 2; ++e )
+            {
+                engines[e].setEndgame(m_Specs[e].endgame);
+                engines[e].setAlgorithm(m_Specs[e].algorithm);
+
+                if( !m_Specs[e].patterns.empty() )
+                    engines[e].loadPatterns(m_Specs[e].patterns);
+            }
+
+            for( int opening { m_NextOpening++ }; opening < numOpenings && !m_Decided; opening = m_NextOpening++ )
+            {
+                Reversi         start { m_Size };
+                Reversi::Stone  toMove { Reversi::Stone::WhiteStone };
+
+                if( !setupOpening(opening, start, toMove) )
+                    continue;
+
+                for( int aIsWhite { 0 }; aIsWhite < 2; ++aIsWhite )
+                {
+                    Results     game {};
+                    const int   diff { playGame(engines, start, toMove, 0 != aIsWhite, game) };
+
+                    game.wins   = diff > 0;
+                    game.draws  = 0 == diff;
+                    game.losses = diff < 0;
+                    report(game);
+                }
+            }
+        }
+
+        /*! @brief set up an opening
+         *
+         * @param opening   number of the opening
+         * @param reversi   game to set up
+         * @param toMove    stone to move after the opening
+         * @return          false if the game is over before the opening ends
+         */
+        bool setupOpening( const int opening, Reversi& reversi, Reversi::Stone& toMove ) const
+        {
+            std::mt19937    random { TestPositions::randomSeed + static_cast<uint32_t>(opening) };
+            const auto*     line { m_Openings.empty() ? nullptr : &m_Openings[opening % m_Openings.size()] };
+            const int       plies { line ? static_cast<int>(line->size()) : m_Plies };
+
+            for( int ply { 0 }; ply < plies; ++ply )
+            {
+                const FieldList moves { TestPositions::getMovesOrPass(reversi, toMove) };
+
+                if( 0 == moves.size() )
+                    return false;
+
+                int idx { TestPositions::randomIndex(moves, random) };
+
+                if( line )
+                {
+                    const Pos_Vect& pos { ( *line )[ply] };
+
+                    idx = -1;
+
+                    for( size_t i { 0 }; i < moves.size(); ++i )
+                        if( moves[i].getFieldPosition().getX() == pos.getX()
+                            && moves[i].getFieldPosition().getY() == pos.getY() )
+                            idx = static_cast<int>(i);
+
+                    if( idx < 0 )                                                   // invalid: opening ends here
+                        break;
+                }
+
+                reversi.makeMove(moves[idx], toMove);
+                toMove = Reversi::otherColor(toMove);
+            }
+            return reversi.getMoveCount(toMove) > 0 || reversi.getMoveCount(Reversi::otherColor(toMove)) > 0;
+        }
+
+        /*! @brief play a game to its end
+         *
+         * @param engines   engine A and B
+         * @param start     position after the opening
+         * @param toMove    stone to move
+         * @param aIsWhite  true if engine A plays white
+         * @param stats     nodes and times searched are added
+         * @return          disc difference from the view of engine A
+         */
+        int playGame( SearchEngine (&engines)[2], Reversi reversi, Reversi::Stone toMove, const bool aIsWhite,
+                      Results& stats ) const
+        {
+            bool passed { false };
+
+            for( int e { 0 }; e < 2; ++e )
+                engines[e].setHashSize(m_Specs[e].hashMB);                          // a new game, an empty table
+
+            while( true )
+            {
+                const FieldList moves { reversi.getValidMoves(toMove) };
+
+                if( 0 == moves.size() )
+                {
+                    if( passed )
+                        break;
+
+                    passed = true;
+                    toMove = Reversi::otherColor(toMove);
+                    continue;
+                }
+
+                const int   e { ( Reversi::Stone::WhiteStone == toMove ) == aIsWhite ? 0 : 1 };
+                const auto  start { std::chrono::steady_clock::now() };
+
+                engines[e].setPosition(reversi);
+
+                const SearchEngine::MoveInfo info { engines[e].computeNextMove(toMove, m_Specs[e].depth,
+                                                                               m_Specs[e].timeMs) };
+
+                stats.seconds[e] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                stats.nodes[e]   += info.nodes;
+
+                reversi.makeMove(moves[std::max(info.idx, 0)], toMove);
+                toMove = Reversi::otherColor(toMove);
+                passed = false;
+            }
+
+            const int diff { reversi.getWhiteNum() - reversi.getBlackNum() };
+
+            return aIsWhite ? diff : -diff;
+        }
+
+        /*! @brief add the result of a game, print the standings and run the test
+         *
+         * @param game      result of one game
+         */
+        void report( const Results& game )
+        {
+            std::lock_guard<std::mutex> lock { m_Mutex };
+
+            m_Results.wins   += game.wins;
+            m_Results.draws  += game.draws;
+            m_Results.losses += game.losses;
+
+            for( int e { 0 }; e < 2; ++e )
+            {
+                m_Results.nodes[e]   += game.nodes[e];
+                m_Results.seconds[e] += game.seconds[e];
+            }
+
+            std::printf("\rgames %5d  +%d =%d -%d  elo %+7.1f", m_Results.games(), m_Results.wins, m_Results.draws,
+                        m_Results.losses, toElo(m_Results.score()));
+
+            if( m_Sprt )
+            {
+                const double llr { logLikelihoodRatio(m_Results, m_Elo0, m_Elo1) };
+
+                std::printf("  llr %+5.2f [%+.2f, %+.2f]", llr, m_LowerBound, m_UpperBound);
+
+                if( llr >= m_UpperBound || llr <= m_LowerBound )
+                    m_Decided = true;
+            }
+            std::fflush(stdout);
+        }
+
+        const double                        m_LowerBound { std::log(0.05 / 0.95) };     ///< accept H0 below
+        const double                        m_UpperBound { std::log(0.95 / 0.05) };     ///< accept H1 above
+        const EngineSpec                    m_Specs[2];                     ///< settings of engine A and B
+        const int                           m_Size;                         ///< size of the board
+        const int                           m_Plies;                        ///< plies of a random opening
+        const std::vector<std::vector<Pos_Vect>>&   m_Openings;             ///< openings, random ones if empty
+        bool                                m_Sprt { false };               ///< run the test
+        double                              m_Elo0 { 0.0 };                 ///< Elo difference of H0
+        double                              m_Elo1 { 0.0 };                 ///< Elo difference of H1
+        std::atomic<int>                    m_NextOpening { 0 };            ///< next opening to take
+        std::atomic<bool>                   m_Decided { false };            ///< the test decided, stop
+        std::mutex                          m_Mutex;                        ///< guards the results
+        Results                             m_Results;                      ///< results so far
+    };
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+    EngineSpec  specs[2];
+    int         numSpecs { 0 };
+    int         numOpenings { 500 };
+    int         size { 8 };
+    int         plies { 8 };
+    int         numThreads { std::max(static_cast<int>(std::thread::hardware_concurrency()), 1) };
+    double      elo[2] { 0.0, 0.0 };
+    bool        sprt { false };
+    bool        valid { true };
+    std::string openingsPath;
+
+    for( int i { 1 }; i < argc && valid; ++i )
+    {
+        const bool hasValue { i + 1 < argc };
+
+        if( 0 == std::strcmp(argv[i], "-g") && hasValue )           numOpenings  = std::atoi(argv[++i]);
+        else if( 0 == std::strcmp(argv[i], "-s") && hasValue )      size         = std::atoi(argv[++i]);
+        else if( 0 == std::strcmp(argv[i], "-p") && hasValue )      plies        = std::atoi(argv[++i]);
+        else if( 0 == std::strcmp(argv[i], "-o") && hasValue )      openingsPath = argv[++i];
+        else if( 0 == std::strcmp(argv[i], "-j") && hasValue )      numThreads   = std::atoi(argv[++i]);
+        else if( 0 == std::strcmp(argv[i], "-sprt") && i + 2 < argc )
+        {
+            sprt   = true;
+            elo[0] = std::atof(argv[++i]);
+            elo[1] = std::atof(argv[++i]);
+        }
+        else if( '-' != argv[i][0] && numSpecs < 2 )
+            valid = parseSpec(argv[i], specs[numSpecs++]);
+        else
+            valid = false;
+    }
+
+    if( !valid || 2 != numSpecs || size < 4 || size > 10 || size % 2 || numThreads < 1 || ( sprt && elo[0] >= elo[1] ) )
+    {
+        std::printf("usage: reversi_match [-g openings] [-s size] [-p plies] [-o openings-file] [-j threads] "
+                    "[-sprt elo0 elo1] <engineA> <engineB>\n"
+                    "       engine: depth=N,time=MS,hash=MB,endgame=N,patterns=PATH,algo=pvs|mtdf\n");
+        return 1;
+    }
+
+    std::vector<std::vector<Pos_Vect>> openings;
+
+    if( !openingsPath.empty() && !readOpenings(openingsPath, size, plies, openings) )
+    {
+        std::printf("can't read openings from %s\n", openingsPath.c_str());
+        return 1;
+    }
+
+    Match match { specs, size, plies, openings };
+
+    if( sprt )
+        match.setSprt(elo[0], elo[1]);
+
+    const auto      start { std::chrono::steady_clock::now() };
+    const Results   results { match.run(numOpenings, numThreads) };
+    const double    seconds { std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+    const double    error { 1.96 * std::sqrt(results.variance() / std::max(results.games(), 1)) };
+
+    std::printf("\n\n%d games in %.1f s, A: +%d =%d -%d, score %.3f\n", results.games(), seconds, results.wins,
+                results.draws, results.losses, results.score());
+    std::printf("elo difference %+.1f, 95%% interval [%+.1f, %+.1f]\n", toElo(results.score()),
+                toElo(results.score() - error), toElo(results.score() + error));
+
+    for( int e { 0 }; e < 2; ++e )
+        std::printf("engine %c: %.1f cpu s searching, %.0f nodes/s\n", 'A' + e, results.seconds[e],
+                    results.nodes[e] / std::max(results.seconds[e], 1e-3));
+
+    if( sprt )
+        std::printf("sprt [%+.1f, %+.1f]: %s\n", elo[0], elo[1], match.sprtVerdict().c_str());
+
+    return 0;
+}
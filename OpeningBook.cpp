@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+
+#include "OpeningBook.h"
+
+// =====================================================================================================================
+
+bool OpeningBook::load( const std::string& path, const int boardSize )
+{
+    m_Entries    = nullptr;
+    m_NumEntries = 0;
+
+    Header header {};
+
+    if( !m_File.openChecked(path, "RVBK", m_Version, boardSize, header) )
+        return false;
+
+    if( 0 == header.numEntries || m_File.size() != sizeof(header) + header.numEntries * sizeof(Entry) )
+    {
+        m_File.close();
+        return false;
+    }
+
+    m_Entries    = reinterpret_cast<const Entry*>(m_File.data() + sizeof(header));
+    m_NumEntries = header.numEntries;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool OpeningBook::probe( const uint64_t key, Entry& entry ) const
+{
+    const Entry* end { m_Entries + m_NumEntries };
+    const Entry* found { std::lower_bound(m_Entries, end, key,
+                                          []( const Entry& e, const uint64_t k ) { return e.key < k; }) };
+
+    if( end == found || found->key != key )
+        return false;
+
+    entry = *found;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool OpeningBook::write( const std::string& path, const int boardSize, std::vector<Entry> entries )
+{
+    std::sort(entries.begin(), entries.end(), []( const Entry& a, const Entry& b ) { return a.key < b.key; });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              []( const Entry& a, const Entry& b ) { return a.key == b.key; }),
+                  entries.end());
+
+    const Header header { { 'R', 'V', 'B', 'K' }, m_Version, static_cast<uint32_t>(boardSize),
+                          static_cast<uint32_t>(entries.size()) };
+
+    return MappedFile::writeReplacing(path, { { &header, sizeof(header) },
+                                              { entries.data(), entries.size() * sizeof(Entry) } });
+}
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "Reversi.h"
+
+// =====================================================================================================================
+
+/*! @brief analyzed opening positions with their best move, read from a memory-mapped file
+ * @details The book is a binary file, in host byte order:
+ * - header: magic "RVBK", format version, board size, number of entries
+ * - the entries sorted by key: key of the position, score, best move and depth of the analysis
+ *
+ * The key is the Zobrist hash of the stones, XOR-ed with the side key if white is to move - the same key the search
+ * uses for its transposition table. A position is found by a binary search on the mapped entries, so loading is
+ * instant and all processes using the same book share one copy of it.
+ *
+ * It contains
+ * - the mapped file
+ *
+ * It implements
+ * - loading and checking a book
+ * - looking up a position
+ * - writing a book from a list of entries
+ */
+class OpeningBook
+{
+public:
+    static constexpr const uint32_t m_Version { 1 };                        ///< version of the file format
+
+    /// @brief header of a book
+    struct Header
+    {
+        char        magic[4];                                               ///< "RVBK"
+        uint32_t    version;                                                ///< m_Version
+        uint32_t    boardSize;                                              ///< size of the board of all positions
+        uint32_t    numEntries;                                             ///< number of entries
+    };
+
+    /// @brief analysis of a position
+    struct Entry
+    {
+        uint64_t    key;                                                    ///< key of the position
+        int16_t     score;                                                  ///< score of the best move
+        uint8_t     move;                                                   ///< best move, packed (x << 4 | y)
+        uint8_t     depth;                                                  ///< depth of the analysis
+        uint32_t    reserved;                                               ///< 0, keeps entries at 16 bytes
+    };
+
+    /*! @brief map a book, replacing the one loaded before
+     *
+     * @param path      name of the file
+     * @param boardSize size of the board the book has to be for
+     * @return          false if the file is missing or its header or size doesn't match - no book is loaded then
+     */
+    bool load( const std::string& path, const int boardSize );
+
+    /*! @brief check if a book is loaded
+     *
+     * @return          true if so
+     */
+    bool isLoaded() const
+    { return nullptr != m_Entries; }
+
+    /*! @brief get the number of positions
+     *
+     * @return          number of entries
+     */
+    size_t size() const
+    { return m_NumEntries; }
+
+    /*! @brief look up a position
+     *
+     * @param key       key of the position, see makeKey()
+     * @param entry     the entry, if found
+     * @return          true if found
+     */
+    bool probe( const uint64_t key, Entry& entry ) const;
+
+    /*! @brief get the key of a position
+     *
+     * @param position  the game
+     * @param stone     stone to move
+     * @return          key
+     */
+    static uint64_t makeKey( const Reversi& position, const Reversi::Stone stone )
+    { return Reversi::Stone::WhiteStone == stone ? position.getHash() ^ Zobrist::sideKey() : position.getHash(); }
+
+    /*! @brief write a book, entries with the same key are written once
+     *
+     * @param path      name of the file
+     * @param boardSize size of the board
+     * @param entries   entries in any order
+     * @return          false if the file can't be written
+     */
+    static bool write( const std::string& path, const int boardSize, std::vector<Entry> entries );
+
+private:
+    MappedFile      m_File;                                                 ///< the mapped file
+    const Entry*    m_Entries { nullptr };                                  ///< first entry
+    size_t          m_NumEntries { 0 };                                     ///< number of entries
+};
+
+#endif //OPENINGBOOK_H
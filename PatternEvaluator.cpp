@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "BitBoard.h"
+#include "PatternEvaluator.h"
+
+// =====================================================================================================================
+
+// fields as x, y - the first edge is y == 0, the first corner is (0, 0)
+const std::array<PatternEvaluator::PatternType, 8> PatternEvaluator::m_Types { {
+    { 10, { 0,0, 1,0, 2,0, 3,0, 4,0, 5,0, 6,0, 7,0, 1,1, 6,1 }, 4 },                  // edge + 2X
+    {  9, { 0,0, 1,0, 2,0, 0,1, 1,1, 2,1, 0,2, 1,2, 2,2 }, 4 },                       // corner 3x3
+    { 10, { 0,0, 1,0, 2,0, 3,0, 4,0, 0,1, 1,1, 2,1, 3,1, 4,1 }, 8 },                  // corner 2x5
+    {  8, { 0,0, 1,1, 2,2, 3,3, 4,4, 5,5, 6,6, 7,7 }, 2 },                            // diagonal of 8
+    {  7, { 0,1, 1,2, 2,3, 3,4, 4,5, 5,6, 6,7 }, 4 },                                 //             7
+    {  6, { 0,2, 1,3, 2,4, 3,5, 4,6, 5,7 }, 4 },                                      //             6
+    {  5, { 0,3, 1,4, 2,5, 3,6, 4,7 }, 4 },                                           //             5
+    {  4, { 0,4, 1,5, 2,6, 3,7 }, 4 }                                                 //             4
+} };
+
+// constant-initialized, the table is computed by the compiler
+const std::array<uint16_t, 1 << PatternEvaluator::m_MaxPatternFields>
+    PatternEvaluator::m_Ternary { PatternEvaluator::makeTernary() };
+
+const std::vector<PatternEvaluator::Instance> PatternEvaluator::m_Instances { PatternEvaluator::makeInstances() };
+
+const size_t PatternEvaluator::m_PhaseSize { PatternEvaluator::countWeights() };
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// symmetry 0..3 rotates by 0, 90, 180, 270 degrees, 4..7 mirrors at the diagonal first
+std::vector<PatternEvaluator::Instance> PatternEvaluator::makeInstances()
+{
+    std::vector<Instance>   instances;
+    int                     offset { 0 };
+
+    for( const auto& type : m_Types )
+    {
+        int configurations { 1 };
+
+        for( int symmetry { 0 }; symmetry < type.numSymmetries; ++symmetry )
+        {
+            Instance instance { offset, type.numFields, {} };
+
+            for( int i { 0 }; i < type.numFields; ++i )
+            {
+                int x { type.fields[2 * i] };
+                int y { type.fields[2 * i + 1] };
+
+                if( symmetry >= 4 ) std::swap(x, y);
+
+                for( int r { 0 }; r < symmetry % 4; ++r )
+                {
+                    const int rotated { m_BoardSize - 1 - y };
+                    y = x;
+                    x = rotated;
+                }
+                instance.fields[i] = BitBoard<m_BoardSize>::index(x, y);
+            }
+            instances.push_back(instance);
+        }
+
+        for( int i { 0 }; i < type.numFields; ++i )
+            configurations *= 3;
+
+        offset += configurations;
+    }
+    return instances;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+size_t PatternEvaluator::countWeights()
+{
+    const Instance& last { m_Instances.back() };
+    size_t          configurations { 1 };
+
+    for( int i { 0 }; i < last.numFields; ++i )
+        configurations *= 3;
+
+    return last.offset + configurations;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::vector<int16_t> PatternEvaluator::makeFieldPhase( const std::array<int, m_BoardSize * m_BoardSize>& fieldWeights )
+{
+    std::vector<int16_t>                            weights( m_PhaseSize, 0 );
+    std::array<bool, m_BoardSize * m_BoardSize>     taken {};
+    size_t                                          first { 0 };                // first instance of a type
+
+    while( first < m_Instances.size() )
+    {
+        const Instance&                         type { m_Instances[first] };
+        size_t                                  end { first };
+        std::array<int, m_MaxPatternFields>     scored {};                      // weight per field of the type
+        int                                     configurations { 1 };
+
+        while( end < m_Instances.size() && m_Instances[end].offset == type.offset )
+            ++end;
+
+        for( int i { 0 }; i < type.numFields; ++i )
+        {
+            std::array<bool, m_BoardSize * m_BoardSize>     covered { taken };
+            bool                                            free { true };
+
+            for( size_t instance { first }; instance < end; ++instance )        // free and not twice in the type
+            {
+                const int field { m_Instances[instance].fields[i] };
+
+                if( fieldWeights[field] != fieldWeights[type.fields[i]] )
+                    throw std::logic_error("Field weights must be symmetric");
+
+                free           = free && !covered[field];
+                covered[field] = true;
+            }
+
+            if( free )
+            {
+                taken     = covered;
+                scored[i] = fieldWeights[type.fields[i]];
+            }
+            configurations *= 3;
+        }
+
+        for( int configuration { 0 }; configuration < configurations; ++configuration )
+        {
+            int digits { configuration };
+            int score { 0 };
+
+            for( int i { 0 }; i < type.numFields; ++i, digits /= 3 )            // digit i: field i empty, own, opponent
+                score += 1 == digits % 3 ? scored[i] : 2 == digits % 3 ? -scored[i] : 0;
+
+            weights[type.offset + configuration] = static_cast<int16_t>(score);
+        }
+        first = end;
+    }
+
+    if( taken.end() != std::find(taken.begin(), taken.end(), false) )
+        throw std::logic_error("Not every field is scored by a pattern");
+
+    return weights;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool PatternEvaluator::write( const std::string& path, const std::vector<int16_t>& weights )
+{
+    const size_t numPhases { weights.size() / m_PhaseSize };
+
+    if( 0 != weights.size() % m_PhaseSize || numPhases < 1 || numPhases > m_MaxPhases )
+        throw std::logic_error("Weights must be 1 to 61 phases");
+
+    const Header header { { 'R', 'V', 'P', 'W' }, m_Version, static_cast<uint32_t>(m_BoardSize),
+                          static_cast<uint32_t>(numPhases) };
+
+    return MappedFile::writeReplacing(path, { { &header, sizeof(header) },
+                                              { weights.data(), weights.size() * sizeof(int16_t) } });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool PatternEvaluator::load( const std::string& path )
+{
+    m_Weights   = nullptr;
+    m_NumPhases = 0;
+
+    Header header {};
+
+    if( !m_File.openChecked(path, "RVPW", m_Version, m_BoardSize, header) )
+        return false;
+
+    if( header.numPhases < 1 || header.numPhases > m_MaxPhases
+        || m_File.size() != sizeof(header) + header.numPhases * m_PhaseSize * sizeof(int16_t) )
+    {
+        m_File.close();
+        return false;
+    }
+
+    m_Weights   = reinterpret_cast<const int16_t*>(m_File.data() + sizeof(header));
+    m_NumPhases = static_cast<int>(header.numPhases);
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int PatternEvaluator::evaluate( const uint64_t own, const uint64_t opp ) const
+{
+    const int       empties { m_BoardSize * m_BoardSize - BitOps::popCount(own | opp) };
+    const int16_t*  weights { m_Weights + empties * m_NumPhases / m_MaxPhases * m_PhaseSize };
+    int             score { 0 };
+
+    for( const auto& instance : m_Instances )
+    {
+        unsigned ownMask { 0 };
+        unsigned oppMask { 0 };
+
+        for( int i { 0 }; i < instance.numFields; ++i )
+        {
+            ownMask |= static_cast<unsigned>(( own >> instance.fields[i] ) & 1) << i;
+            oppMask |= static_cast<unsigned>(( opp >> instance.fields[i] ) & 1) << i;
+        }
+        score += weights[instance.offset + m_Ternary[ownMask] + 2 * m_Ternary[oppMask]];
+    }
+    return score;
+}
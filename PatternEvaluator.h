@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef PATTERNEVALUATOR_H
+#define PATTERNEVALUATOR_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+// =====================================================================================================================
+
+/*! @brief evaluation of 8x8 positions by the weights of patterns of fields, read from a memory-mapped file
+ * @details The position is cut into overlapping patterns: the edges together with their two X-fields, the 3x3 blocks
+ * and the 2x5 blocks in the corners, and the diagonals of 4 to 8 fields. Every instance of a pattern type - the same
+ * fields rotated or mirrored - shares the table of weights of its type. A pattern with n fields has 3^n
+ * configurations, each field being empty, own (side to move) or the opponent's. The index of a configuration is
+ * computed by gathering the own and the opponent's fields into one bit each and converting these masks to base 3 by
+ * a lookup table. There is a set of tables per game phase, the phase is given by the number of empty fields.
+ *
+ * The weights are loaded from a binary file, in host byte order:
+ * - header: magic "RVPW", format version, board size (8), number of phases
+ * - per phase, per pattern type: 3^n weights as int16_t, in the order of m_Types
+ *
+ * The file is mapped, not read - so loading is instant, and all processes using the same file share one copy.
+ *
+ * It contains
+ * - the mapped weights
+ * - the fields of all pattern instances, built once
+ *
+ * It implements
+ * - loading and checking a file of weights
+ * - the evaluation of a position from the view of the side to move
+ */
+class PatternEvaluator
+{
+public:
+    static constexpr const uint32_t     m_Version { 1 };                    ///< version of the file format
+    static constexpr const int          m_BoardSize { 8 };                  ///< only size with patterns
+    static constexpr const int          m_MaxPhases { 61 };                 ///< one phase per number of empty fields
+
+    /// @brief header of a file of weights
+    struct Header
+    {
+        char        magic[4];                                               ///< "RVPW"
+        uint32_t    version;                                                ///< m_Version
+        uint32_t    boardSize;                                              ///< m_BoardSize
+        uint32_t    numPhases;                                              ///< number of game phases, 1 .. 61
+    };
+
+    /*! @brief map a file of weights, replacing the ones loaded before
+     *
+     * @param path      name of the file
+     * @return          false if the file is missing or its header or size doesn't match - no weights are loaded then
+     */
+    bool load( const std::string& path );
+
+    /*! @brief check if weights are loaded
+     *
+     * @return          true if so
+     */
+    bool isLoaded() const
+    { return nullptr != m_Weights; }
+
+    /*! @brief evaluate a position, weights must be loaded
+     *
+     * @param own       stones of the side to move
+     * @param opp       stones of the opponent
+     * @return          sum of the weights of all pattern instances
+     */
+    int evaluate( const uint64_t own, const uint64_t opp ) const;
+
+    /*! @brief get the number of weights of one phase
+     *
+     * @return          number of weights
+     */
+    static size_t getPhaseSize()
+    { return m_PhaseSize; }
+
+    /*! @brief make the weights of one phase scoring each stone by the weight of its field
+     * @details The fields of the pattern types are taken in order if all their instances cover fields not taken yet,
+     * this way every field of the board is scored by exactly one field of one pattern type. evaluate() gives the sum
+     * of the weights of the fields of the own stones minus the ones of the opponent then.
+     *
+     * @param fieldWeights  weight per field, by bit index - the same for the fields of a pattern's instances
+     * @return              weights of one phase, in the order of the file
+     */
+    static std::vector<int16_t> makeFieldPhase( const std::array<int, m_BoardSize * m_BoardSize>& fieldWeights );
+
+    /*! @brief write a file of weights
+     *
+     * @param path      name of the file
+     * @param weights   weights of all phases, 1 .. m_MaxPhases times getPhaseSize()
+     * @return          false if the file can't be written
+     */
+    static bool write( const std::string& path, const std::vector<int16_t>& weights );
+
+private:
+    static constexpr const int m_MaxPatternFields { 10 };                   ///< fields of the largest pattern
+
+    /// @brief a type of pattern: its fields in one corner or on one edge, the others are rotated or mirrored
+    struct PatternType
+    {
+        int                                         numFields;              ///< number of fields
+        std::array<int, 2 * m_MaxPatternFields>     fields;                 ///< x, y per field
+        int                                         numSymmetries;          ///< instances: the first 2, 4 or 8
+                                                                            ///      rotations and mirrors
+    };
+
+    /// @brief one instance of a pattern on the board
+    struct Instance
+    {
+        int                                     offset;                     ///< first weight of its type in a phase
+        int                                     numFields;                  ///< number of fields
+        std::array<int, m_MaxPatternFields>     fields;                     ///< bit index per field
+    };
+
+    /*! @brief build all pattern instances
+     *
+     * @return          instances
+     */
+    static std::vector<Instance> makeInstances();
+
+    /*! @brief count the weights of one phase, from the instances
+     *
+     * @return          number of weights
+     */
+    static size_t countWeights();
+
+    /*! @brief build the table converting a mask of bits to base 3
+     *
+     * @return          table
+     */
+    static constexpr std::array<uint16_t, 1 << m_MaxPatternFields> makeTernary()
+    {
+        std::array<uint16_t, 1 << m_MaxPatternFields> table {};
+
+        for( int mask { 0 }; mask < ( 1 << m_MaxPatternFields ); ++mask )
+        {
+            int value { 0 };
+
+            for( int bit { m_MaxPatternFields - 1 }; bit >= 0; --bit )
+                value = value * 3 + ( ( mask >> bit ) & 1 );
+
+            table[mask] = static_cast<uint16_t>(value);
+        }
+        return table;
+    }
+
+    static const std::array<PatternType, 8>     m_Types;                    ///< edge + 2X, corner 3x3, corner 2x5,
+                                                                            ///      diagonals of 8 .. 4 fields
+    static const std::array<uint16_t, 1 << m_MaxPatternFields>  m_Ternary;  ///< bits as base 3 number
+    static const std::vector<Instance>          m_Instances;                ///< all instances on the board
+    static const size_t                         m_PhaseSize;                ///< weights per phase
+
+    MappedFile                                  m_File;                     ///< the mapped file
+    const int16_t*                              m_Weights { nullptr };      ///< first weight of the first phase
+    int                                         m_NumPhases { 0 };          ///< number of phases in the file
+};
+
+#endif //PATTERNEVALUATOR_H
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "PatternEvaluator.h"
+#include "Reversi.h"
+#include "TestPositions.h"
+
+// =====================================================================================================================
+
+// write a file of pattern weights derived from the field weights - usage: pattern_gen [weights [games]]
+//
+// every field of the 8x8 board is scored by one field of one pattern type with its weight of EvalWeights, so the
+// pattern evaluation of any position is the positional score of the heuristic evaluation - a start for weights fitted
+// to games, and a reference to check the loading and the evaluation. The file has one phase, default:
+// reversi-patterns.bin. It is loaded again and compared to Reversi::getPositional on all positions of the given number
+// of random games (default: 1000), for both sides. Fitting the weights to games is left to a tool of its own.
+
+namespace
+{
+    constexpr const int boardSize { PatternEvaluator::m_BoardSize };    ///< size of the board
+
+    /*! @brief compare the pattern evaluation of a position to its positional score, for both sides
+     *
+     * @param patterns  loaded weights
+     * @param reversi   position
+     * @return          number of sides evaluated differently
+     */
+    int compare( const PatternEvaluator& patterns, const Reversi& reversi )
+    {
+        const auto& bits { std::get<BitBoard<boardSize>>(reversi.getBitBoard()) };
+        int         differences { 0 };
+
+        for( const bool white : { true, false } )
+        {
+            const Reversi::Stone stone { white ? Reversi::Stone::WhiteStone : Reversi::Stone::BlackStone };
+
+            if( patterns.evaluate(bits.getStones(white), bits.getStones(!white)) != reversi.getPositional(stone) )
+                ++differences;
+        }
+        return differences;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+    const std::string   path { argc > 1 ? argv[1] : "reversi-patterns.bin" };
+    const int           games { argc > 2 ? std::atoi(argv[2]) : 1000 };
+
+    std::array<int, boardSize * boardSize> fieldWeights {};
+
+    for( int x { 0 }; x < boardSize; ++x )
+        for( int y { 0 }; y < boardSize; ++y )
+            fieldWeights[BitBoard<boardSize>::index(x, y)] = EvalWeights::fieldWeight({ x, y }, boardSize);
+
+    if( !PatternEvaluator::write(path, PatternEvaluator::makeFieldPhase(fieldWeights)) )
+    {
+        std::printf("can't write %s\n", path.c_str());
+        return 1;
+    }
+
+    PatternEvaluator patterns;
+
+    if( !patterns.load(path) )
+    {
+        std::printf("can't load %s\n", path.c_str());
+        return 1;
+    }
+
+    std::mt19937    random { TestPositions::randomSeed };
+    long long       positions { 0 };
+    long long       differences { 0 };
+
+    for( int game { 0 }; game < games; ++game )
+    {
+        Reversi         reversi { boardSize };
+        Reversi::Stone  toMove { Reversi::Stone::WhiteStone };
+
+        while( true )
+        {
+            differences += compare(patterns, reversi);
+            positions   += 2;
+
+            if( !TestPositions::makeRandomMove(reversi, toMove, random) )
+                break;
+        }
+    }
+
+    std::printf("written to %s, %lld evaluations of %d games checked, %lld differ from the positional score\n",
+                path.c_str(), positions, games, differences);
+
+    return 0 == differences ? 0 : 1;
+}
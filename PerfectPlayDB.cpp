@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "PerfectPlayDB.h"
+
+// =====================================================================================================================
+
+bool PerfectPlayDB::load( const std::string& path, const int boardSize )
+{
+    m_Keys       = nullptr;
+    m_Scores     = nullptr;
+    m_NumEntries = 0;
+
+    Header header {};
+
+    if( !m_File.openChecked(path, "RVDB", m_Version, boardSize, header) )
+        return false;
+
+    if( 0 == header.numEntries
+        || m_File.size() != sizeof(header) + header.numEntries * ( sizeof(uint64_t) + sizeof(int8_t) ) )
+    {
+        m_File.close();
+        return false;
+    }
+
+    m_Keys       = reinterpret_cast<const uint64_t*>(m_File.data() + sizeof(header));
+    m_Scores     = reinterpret_cast<const int8_t*>(m_Keys + header.numEntries);
+    m_NumEntries = header.numEntries;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool PerfectPlayDB::probe( const uint64_t key, int& score ) const
+{
+    const uint64_t* end { m_Keys + m_NumEntries };
+    const uint64_t* found { std::lower_bound(m_Keys, end, key) };
+
+    if( end == found || *found != key )
+        return false;
+
+    score = m_Scores[found - m_Keys];
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// symmetry 0..3 rotates by 0, 90, 180, 270 degrees, 4..7 mirrors at the diagonal first - 3^36 * 2 still fits 64 bits
+uint64_t PerfectPlayDB::canonicalKey( const Reversi& position, const Reversi::Stone stone )
+{
+    const int size { position.getSize() };
+
+    if( size > 6 ) throw std::logic_error("No perfect play database for this board size");
+
+    uint64_t best { UINT64_MAX };
+
+    for( int symmetry { 0 }; symmetry < 8; ++symmetry )
+    {
+        uint64_t key { 0 };
+
+        for( int x { 0 }; x < size; ++x )
+        {
+            for( int y { 0 }; y < size; ++y )
+            {
+                int sx { symmetry >= 4 ? y : x };                                   // field mapped to (x, y)
+                int sy { symmetry >= 4 ? x : y };
+
+                for( int r { 0 }; r < symmetry % 4; ++r )
+                {
+                    const int rotated { size - 1 - sy };
+                    sy = sx;
+                    sx = rotated;
+                }
+
+                const Reversi::Stone    field { position.peekField({ sx, sy }) };
+                const int               digit { Reversi::Stone::BlackStone == field ? 1
+                                                : Reversi::Stone::WhiteStone == field ? 2 : 0 };
+
+                key = key * 3 + digit;
+            }
+        }
+        best = std::min(best, key);
+    }
+    return best * 2 + ( Reversi::Stone::WhiteStone == stone ? 1 : 0 );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool PerfectPlayDB::write( const std::string& path, const int boardSize, std::vector<Entry> entries )
+{
+    std::sort(entries.begin(), entries.end(), []( const Entry& a, const Entry& b ) { return a.key < b.key; });
+
+    const Header            header { { 'R', 'V', 'D', 'B' }, m_Version, static_cast<uint32_t>(boardSize),
+                                     static_cast<uint32_t>(entries.size()) };
+    std::vector<uint64_t>   keys;
+    std::vector<int8_t>     scores;
+
+    for( const auto& entry : entries )
+    {
+        keys.push_back(entry.key);
+        scores.push_back(entry.score);
+    }
+
+    return MappedFile::writeReplacing(path, { { &header, sizeof(header) },
+                                              { keys.data(), keys.size() * sizeof(uint64_t) },
+                                              { scores.data(), scores.size() * sizeof(int8_t) } });
+}
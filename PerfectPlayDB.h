@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef PERFECTPLAYDB_H
+#define PERFECTPLAYDB_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "Reversi.h"
+
+// =====================================================================================================================
+
+/*! @brief exact scores of positions of the small boards, read from a memory-mapped file
+ * @details The 4x4 game can be solved completely, the 6x6 game up to a number of plies - the db_solver tool does so.
+ * The result is the final disc difference with perfect play of both sides, for every position reached.
+ *
+ * A position is keyed by its canonical form: the fields are read as a base 3 number (empty, black, white) for each of
+ * the 8 rotations and mirrors of the board, the smallest one counts, then the side to move is added as the lowest bit.
+ * So all symmetrical positions share one entry.
+ *
+ * The database is a binary file, in host byte order:
+ * - header: magic "RVDB", format version, board size, number of entries
+ * - the keys in ascending order, uint64_t each
+ * - the scores in the same order, int8_t each: final disc difference from the view of the side to move
+ *
+ * It contains
+ * - the mapped file
+ *
+ * It implements
+ * - computing the canonical key of a position
+ * - loading and checking a database
+ * - looking up a position
+ * - writing a database from a list of entries
+ */
+class PerfectPlayDB
+{
+public:
+    static constexpr const uint32_t m_Version { 1 };                        ///< version of the file format
+
+    /// @brief header of a database
+    struct Header
+    {
+        char        magic[4];                                               ///< "RVDB"
+        uint32_t    version;                                                ///< m_Version
+        uint32_t    boardSize;                                              ///< size of the board of all positions
+        uint32_t    numEntries;                                             ///< number of positions
+    };
+
+    /// @brief a solved position
+    struct Entry
+    {
+        uint64_t    key;                                                    ///< canonical key
+        int8_t      score;                                                  ///< final disc difference
+    };
+
+    /*! @brief map a database, replacing the one loaded before
+     *
+     * @param path      name of the file
+     * @param boardSize size of the board the database has to be for
+     * @return          false if the file is missing or its header or size doesn't match - nothing is loaded then
+     */
+    bool load( const std::string& path, const int boardSize );
+
+    /*! @brief check if a database is loaded
+     *
+     * @return          true if so
+     */
+    bool isLoaded() const
+    { return nullptr != m_Keys; }
+
+    /*! @brief get the number of positions
+     *
+     * @return          number of entries
+     */
+    size_t size() const
+    { return m_NumEntries; }
+
+    /*! @brief look up a position
+     *
+     * @param key       canonical key of the position
+     * @param score     final disc difference from the view of the side to move, if found
+     * @return          true if found
+     */
+    bool probe( const uint64_t key, int& score ) const;
+
+    /*! @brief get the canonical key of a position, the board must not be larger than 6x6
+     *
+     * @param position  the game
+     * @param stone     stone to move
+     * @return          key
+     */
+    static uint64_t canonicalKey( const Reversi& position, const Reversi::Stone stone );
+
+    /*! @brief write a database
+     *
+     * @param path      name of the file
+     * @param boardSize size of the board
+     * @param entries   entries in any order, each key once
+     * @return          false if the file can't be written
+     */
+    static bool write( const std::string& path, const int boardSize, std::vector<Entry> entries );
+
+private:
+    MappedFile          m_File;                                             ///< the mapped file
+    const uint64_t*     m_Keys { nullptr };                                 ///< first key
+    const int8_t*       m_Scores { nullptr };                               ///< first score
+    size_t              m_NumEntries { 0 };                                 ///< number of entries
+};
+
+#endif //PERFECTPLAYDB_H
@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Reversi.h"
+
+// =====================================================================================================================
+
+// count the positions reached after a number of plies from the start - usage: perft [size [depth [divide|hash]]]
+//
+// without a size all boards are counted, 4x4 .. 10x10. A pass is a ply of its own, as in the game where the player who
+// can't move has to confirm it, a finished game counts as one position whatever depth is left. White moves first.
+// "divide" prints the count per move of the start position, "hash" remembers the counts of positions already seen.
+
+namespace
+{
+    /// @brief counts the positions by making and undoing all moves
+    class Perft
+    {
+    public:
+        /*! @brief constructor
+         *
+         * @param size      size of the board
+         * @param useHash   true to remember counts of positions
+         */
+        Perft( const int size, const bool useHash )
+            : m_Reversi { size }
+            , m_MoveStack( 2 * size * size )                                // a pass between any two moves
+            , m_Table( useHash ? m_TableSize : 0 )
+        {}
+
+        /*! @brief count the positions
+         *
+         * @param stone     stone to move
+         * @param depth     number of plies
+         * @param ply       index into the move stack
+         * @return          number of positions
+         */
+        uint64_t count( const Reversi::Stone stone, const int depth, const int ply = 0 )
+        {
+            if( 0 == depth )
+                return 1;
+
+            const uint64_t key { ( Reversi::Stone::WhiteStone == stone ? Zobrist::sideKey() : 0 )
+                                 ^ m_Reversi.getHash() ^ ( static_cast<uint64_t>(depth) * 0x9e3779b97f4a7c15ULL ) };
+            Entry*         entry { m_Table.empty() ? nullptr : &m_Table[key & ( m_TableSize - 1 )] };
+
+            if( entry && entry->key == key )
+                return entry->count;
+
+            FieldList&              moves { m_MoveStack[ply] };
+            const Reversi::Stone    other { Reversi::otherColor(stone) };
+            uint64_t                nodes { 0 };
+
+            m_Reversi.getValidMoves(stone, moves);
+
+            if( 0 == moves.size() )
+                nodes = 0 == m_Reversi.getMoveCount(other) ? 1 : count(other, depth - 1, ply + 1);
+            else
+            {
+                for( size_t i { 0 }; i < moves.size(); ++i )
+                {
+                    m_Reversi.makeMove(moves[i], stone);
+                    nodes += count(other, depth - 1, ply + 1);
+                    m_Reversi.undoMove(moves[i]);
+                }
+            }
+
+            if( entry )
+                *entry = { key, nodes };
+
+            return nodes;
+        }
+
+        /*! @brief count the positions per move of the start position and print them
+         *
+         * @param stone     stone to move
+         * @param depth     number of plies, at least 1
+         * @return          number of positions
+         */
+        uint64_t divide( const Reversi::Stone stone, const int depth )
+        {
+            FieldList&  moves { m_MoveStack[0] };
+            uint64_t    nodes { 0 };
+
+            m_Reversi.getValidMoves(stone, moves);
+
+            for( size_t i { 0 }; i < moves.size(); ++i )
+            {
+                const Pos_Vect pos { moves[i].getFieldPosition() };
+
+                m_Reversi.makeMove(moves[i], stone);
+
+                const uint64_t moveNodes { count(Reversi::otherColor(stone), depth - 1, 1) };
+
+                m_Reversi.undoMove(moves[i]);
+
+                std::printf("  %c%d %14llu\n", 'a' + pos.getX(), pos.getY() + 1,
+                            static_cast<unsigned long long>(moveNodes));
+                nodes += moveNodes;
+            }
+            return nodes;
+        }
+
+    private:
+        /// @brief remembered count of a position
+        struct Entry
+        {
+            uint64_t    key;                                                ///< hash of position, side and depth
+            uint64_t    count;                                              ///< number of positions
+        };
+
+        static constexpr const size_t   m_TableSize { size_t { 1 } << 22 }; ///< number of entries, 64 MB
+
+        Reversi                         m_Reversi;                          ///< the game
+        std::vector<FieldList>          m_MoveStack;                        ///< list of moves per ply
+        std::vector<Entry>              m_Table;                            ///< remembered counts, if hashing
+    };
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int main( int argc, char* argv[] )
+{
+    const int   size { argc > 1 ? std::atoi(argv[1]) : 0 };
+    const int   depth { argc > 2 ? std::atoi(argv[2]) : 8 };
+    const bool  divide { argc > 3 && 0 == std::strcmp(argv[3], "divide") };
+    const bool  useHash { argc > 3 && 0 == std::strcmp(argv[3], "hash") };
+
+    if( ( 0 != size && ( size < 4 || size > 10 || size % 2 ) ) || depth < 0 || ( argc > 3 && !divide && !useHash ) )
+    {
+        std::printf("usage: perft [size [depth [divide|hash]]], size is 4, 6, 8 or 10, depth at least 0\n");
+        return 1;
+    }
+
+    std::printf("%-6s %6s %16s %10s %14s\n", "board", "depth", "positions", "time [ms]", "positions/s");
+
+    for( int boardSize { 0 == size ? 4 : size }; boardSize <= ( 0 == size ? 10 : size ); boardSize += 2 )
+    {
+        Perft           perft { boardSize, useHash };
+        const auto      start { std::chrono::steady_clock::now() };
+        const uint64_t  nodes { divide && depth > 0 ? perft.divide(Reversi::Stone::WhiteStone, depth)
+                                                    : perft.count(Reversi::Stone::WhiteStone, depth) };
+        const double    ms { std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                             .count() };
+
+        std::printf("%2dx%-3d %6d %16llu %10.1f %14.0f\n", boardSize, boardSize, depth,
+                    static_cast<unsigned long long>(nodes), ms, nodes / std::max(ms, 1e-3) * 1000.0);
+    }
+    return 0;
+}
@@ -6,7 +6,8 @@
 #ifndef QUADRATICBOARD_H
 #define QUADRATICBOARD_H
 
-#include <vector>
+#include <array>
+#include <algorithm>
 #include <stdexcept>
 #include <sstream>
 
@@ -18,14 +19,20 @@
  * @details  This is a N x N board / grid with a certain type of cells that are supplied by template-parameter. It is used
  * for the Reversi-Board and for the Grid-Dispaly as well.
  *
+ * The cells are stored in one flat array, coloumn by coloumn, surrounded by a border of one cell on each side which
+ * holds a "sentinel" value. So a walk along a direction can stop when it reaches the border value instead of checking
+ * the coordinates at every step. A direction is simply a fixed offset to the index of a cell, see toOffset(). The
+ * array is sized for the largest board, so copying a board never allocates and is a single block copy.
+ *
  * It contains
  * - the size of the board
- * - the cells
+ * - the cells, including the border
  *
  * It implements an own iterator and it has functions to
  * - check if a position is on the board (the coordinates are within range)
  * - have a look on a certain field/cell
  * - set a value (stone, char) of a field/cell
+ * - convert positions and directions to indices and offsets of the flat array
  *
  * @tparam FieldType    type of each field / cell
  */
@@ -34,10 +41,11 @@ class QuadraticBoard
 {
     static constexpr const int m_MinBoardSize { 4 };                        ///< minimum allowed size
     static constexpr const int m_MaxBoardSize { 10 };                       ///< maximum allowed size
+    static constexpr const int m_MaxCells { ( m_MaxBoardSize + 2 ) * ( m_MaxBoardSize + 2 ) };  ///< incl. border
 
 public:
 
-    using BoardOfFields = std::vector<std::vector<FieldType>>;              ///< the board type
+    using BoardOfFields = std::array<FieldType, m_MaxCells>;                ///< the board type
 
     /*! @brief special iterator to iterate over the complete board
      *
@@ -51,14 +59,14 @@ public:
          * @param position  current position
          * @param size      size - number of cells in row and coloumn
          */
-        Iterator( BoardOfFields& board, const Pos_Vect& position, int size );
+        Iterator( QuadraticBoard& board, const Pos_Vect& position, int size );
 
         /*! @brief de-refencing
          *
          * @return      referenced field / cell
          */
         FieldType& operator*()
-        { return m_Board[m_CurPos.getX()][m_CurPos.getY()]; }
+        { return m_Board.m_Board[m_Board.toIndex(m_CurPos)]; }
 
         /*! @brief pre-increment
          *
@@ -82,7 +90,7 @@ public:
         { return m_CurPos; }
 
     private:
-        BoardOfFields&  m_Board;                            ///< reference to board
+        QuadraticBoard& m_Board;                            ///< reference to board
         Pos_Vect        m_CurPos;                           ///< current position
         const int       m_Coloumns;                         ///< coloumn-size
         const int       m_Rows;                             ///< row-size
@@ -91,8 +99,9 @@ public:
     /*! @brief constructor
      *
      * @param size      size of board
+     * @param border    value of the cells surrounding the board
      */
-    explicit QuadraticBoard( int size );
+    explicit QuadraticBoard( int size, FieldType border = FieldType {} );
 
     /*! @brief copy constructor
      *
@@ -122,21 +131,53 @@ public:
      * @return          stone
      */
     FieldType peekField( const Pos_Vect& pos ) const
-    { return m_Board[pos.getX()][pos.getY()]; }
+    { return m_Board[toIndex(pos)]; }
+
+    /*!  @brief get a stone from a cell of the flat array, the border cells return the border value
+     *
+     * @param idx       index of the cell, see toIndex()
+     * @return          stone
+     */
+    FieldType peekIndex( const int idx ) const
+    { return m_Board[idx]; }
+
+    /*! @brief get index of a position into the flat array
+     *
+     * @param pos       position on the board
+     * @return          index
+     */
+    int toIndex( const Pos_Vect& pos ) const
+    { return ( pos.getX() + 1 ) * m_Stride + pos.getY() + 1; }
+
+    /*! @brief get position regarding an index into the flat array
+     *
+     * @param idx       index, must not be a border cell
+     * @return          position on the board
+     */
+    Pos_Vect toPosition( const int idx ) const
+    { return { idx / m_Stride - 1, idx % m_Stride - 1 }; }
+
+    /*! @brief get the offset of a direction, adding it to an index moves one step in that direction
+     *
+     * @param direction     direction, e.g. (1, -1)
+     * @return              offset
+     */
+    int toOffset( const Pos_Vect& direction ) const
+    { return direction.getX() * m_Stride + direction.getY(); }
 
     /*! @brief begin-operator
      *
      * @return          iterator describing the first valid position on the board
      */
     Iterator begin()
-    { return { m_Board, { 0, 0 }, m_BoardSize }; }
+    { return { *this, { 0, 0 }, m_BoardSize }; }
 
     /*! @brief end-operator describing the first invalid position regarding the board (off-board)
      * y moves faster, so x out-of-range marks the end
      * @return          iterator "off-board"
      */
     Iterator end()
-    { return { m_Board, { m_BoardSize, 0 }, m_BoardSize }; }
+    { return { *this, { m_BoardSize, 0 }, m_BoardSize }; }
 
     /*! @brief put a "stone" on a field at position ...
      *
@@ -144,17 +185,18 @@ public:
      * @param stone     value / stone to set
      */
     void setToField( const Pos_Vect& pos, FieldType stone )
-    { m_Board[pos.getX()][pos.getY()] = stone; }
+    { m_Board[toIndex(pos)] = stone; }
 
 private:
     int           m_BoardSize;            ///< size / ranges
-    BoardOfFields m_Board;                ///< board of ...
+    int           m_Stride { 0 };         ///< cells per coloumn, including the border
+    BoardOfFields m_Board {};             ///< board of ..., including the border
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 template< typename FieldType>
-QuadraticBoard<FieldType>::Iterator::Iterator( BoardOfFields& board, const Pos_Vect& position, const int size )
+QuadraticBoard<FieldType>::Iterator::Iterator( QuadraticBoard& board, const Pos_Vect& position, const int size )
 : m_Board { board }
 , m_CurPos { position }
 , m_Coloumns { size }
@@ -182,9 +224,9 @@ QuadraticBoard<FieldType>::Iterator::operator++()
 // =====================================================================================================================
 
 template< typename FieldType>
-QuadraticBoard<FieldType>::QuadraticBoard( const int size )
+QuadraticBoard<FieldType>::QuadraticBoard( const int size, const FieldType border )
     : m_BoardSize { size }
-    , m_Board { static_cast<size_t>(m_BoardSize), std::vector<FieldType>(m_BoardSize) }
+    , m_Stride { size + 2 }
 {
     if( m_BoardSize % 2 )
     {
@@ -204,6 +246,16 @@ QuadraticBoard<FieldType>::QuadraticBoard( const int size )
         sstr << "Board size must be at most " << m_MaxBoardSize;
         throw std::logic_error(sstr.str());
     }
+
+    m_Board.fill(border);                                                   // border everywhere ...
+
+    for( int x { 0 }; x < m_BoardSize; ++x )
+    {
+        for( int y { 0 }; y < m_BoardSize; ++y )
+        {
+            m_Board[toIndex({ x, y })] = FieldType {};                      //      ... except on the board
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -214,20 +266,18 @@ bool QuadraticBoard<FieldType>::isValidPostion( const Pos_Vect& pos ) const
     return ( pos.getX() >= 0 && pos.getX() < m_BoardSize && pos.getY() >= 0 && pos.getY() < m_BoardSize );
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+
+// only the cells in use (board plus border) are copied, as one block
 template< typename FieldType>
 QuadraticBoard<FieldType>&  QuadraticBoard<FieldType>::operator=( const QuadraticBoard& b )
 {
     if( this != &b )
     {
         m_BoardSize = b.m_BoardSize;
+        m_Stride    = b.m_Stride;
 
-        for( size_t x { 0 }; x < m_BoardSize; ++x )
-        {
-            for( size_t y { 0 }; y < m_BoardSize; ++y )
-            {
-                m_Board[x][y] = b.m_Board[x][y];
-            }
-        }
+        std::copy_n(b.m_Board.begin(), m_Stride * m_Stride, m_Board.begin());
     }
     return *this;
 }
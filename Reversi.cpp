@@ -15,7 +15,8 @@ const Reversi::ValidDirections
 
 Reversi::Reversi( const int siz )
     : m_BoardSize{siz}
-    , m_Board{siz}
+    , m_Board{siz, Stone::OffBoard}
+    , m_BitBoard{makeBitBoard(siz)}
 {
     for( int i { 0 }; i < m_BoardSize; ++i )
     {
@@ -41,13 +42,32 @@ Reversi::Reversi( const int siz )
     m_Board.setToField({ m_BoardSize / 2 - 1, m_BoardSize / 2 }, Stone::WhiteStone);
     m_Board.setToField({ m_BoardSize / 2, m_BoardSize / 2 - 1 }, Stone::WhiteStone);
     m_WhiteStones = 2;
+
+    m_Hash = Zobrist::stoneKey({ m_BoardSize / 2 - 1, m_BoardSize / 2 - 1 }, false)
+           ^ Zobrist::stoneKey({ m_BoardSize / 2, m_BoardSize / 2 }, false)
+           ^ Zobrist::stoneKey({ m_BoardSize / 2 - 1, m_BoardSize / 2 }, true)
+           ^ Zobrist::stoneKey({ m_BoardSize / 2, m_BoardSize / 2 - 1 }, true);
+
+    m_Positional = EvalWeights::fieldWeight({ m_BoardSize / 2 - 1, m_BoardSize / 2 }, m_BoardSize)
+                 + EvalWeights::fieldWeight({ m_BoardSize / 2, m_BoardSize / 2 - 1 }, m_BoardSize)
+                 - EvalWeights::fieldWeight({ m_BoardSize / 2 - 1, m_BoardSize / 2 - 1 }, m_BoardSize)
+                 - EvalWeights::fieldWeight({ m_BoardSize / 2, m_BoardSize / 2 }, m_BoardSize);
+
+    std::visit([this]( auto& bits )
+               {
+                   bits.set(bits.index(m_BoardSize / 2 - 1, m_BoardSize / 2 - 1), false);
+                   bits.set(bits.index(m_BoardSize / 2, m_BoardSize / 2), false);
+                   bits.set(bits.index(m_BoardSize / 2 - 1, m_BoardSize / 2), true);
+                   bits.set(bits.index(m_BoardSize / 2, m_BoardSize / 2 - 1), true);
+               }, m_BitBoard);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
 Reversi::Reversi( const Reversi& other )
     : m_BoardSize { other.m_BoardSize }
-    , m_Board { m_BoardSize }
+    , m_Board { other.m_Board }
+    , m_BitBoard { other.m_BitBoard }
 {
     *this = other;
 }
@@ -63,8 +83,11 @@ Reversi& Reversi::operator=( const Reversi& other )
         m_NumMoves      = other.m_NumMoves;
         m_BoardSize     = other.m_BoardSize;
         m_Board         = other.m_Board;
+        m_BitBoard      = other.m_BitBoard;
         m_WhiteStones   = other.m_WhiteStones;
         m_BlackStones   = other.m_BlackStones;
+        m_Hash          = other.m_Hash;
+        m_Positional    = other.m_Positional;
     }
     return *this;
 }
@@ -73,9 +96,9 @@ Reversi& Reversi::operator=( const Reversi& other )
 
 Reversi::Stone Reversi::otherColor( const Reversi::Stone stone )
 {
-    if( stone == Stone::NoStone )
+    if( stone == Stone::NoStone || stone == Stone::OffBoard )
     {
-        return Stone::NoStone;
+        return stone;
     }
 
     return stone == Stone::BlackStone ? Stone::WhiteStone : Stone::BlackStone;
@@ -85,33 +108,22 @@ Reversi::Stone Reversi::otherColor( const Reversi::Stone stone )
 
 FieldValue Reversi::checkNeighbor( const Pos_Vect toCheck, const Pos_Vect direction, const Stone stone ) const
 {
-    Pos_Vect    neighborPos  { toCheck + direction };                       // neighbor to check
+    const int   offset       { m_Board.toOffset(direction) };               // step in that direction
+    int         neighborIdx  { m_Board.toIndex(toCheck) + offset };         // neighbor to check
     const Stone oppositStone { otherColor(stone) };                         // look for those
     FieldValue  ret { toCheck };
 
-    while( m_Board.isValidPostion(neighborPos))                             // is the position valid?
+    while( m_Board.peekIndex(neighborIdx) == oppositStone )                 // the border stops the walk as well
     {
-        const Stone checkStone { m_Board.peekField(neighborPos) };          // look at that stone
-
-        if( checkStone == oppositStone )
-        {
-            ret.addValuePosition(neighborPos);                                   // might get flipped
-        }
-        else if( checkStone == Stone::NoStone )                             // invalid position for "toCheck" for "stone"
-        {                                                                   //      regarding "direction"
-            ret.delPostions();
-            return ret;
-        }
-        else
-        {
-            return ret;                                                     // found our own color, so OK
-        }
+        ret.addValuePosition(m_Board.toPosition(neighborIdx));              // might get flipped
+        neighborIdx += offset;                                              // go further in that direction
+    }
 
-        neighborPos += direction;                                           // go further in that direction
+    if( m_Board.peekIndex(neighborIdx) != stone )                           // empty field or border reached ...
+    {
+        ret.delPostions();
     }
-    // boarder reached ...
-    ret.delPostions();
-    return ret;
+    return ret;                                                             // ... otherwise found our own color
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -120,8 +132,15 @@ void Reversi::setStone( const Pos_Vect& pos, Stone stone )
 {
     m_Board.setToField(pos, stone);
 
-    if( Stone::WhiteStone == stone ) ++m_WhiteStones;
-    else                             ++m_BlackStones;
+    std::visit([&pos, stone]( auto& bits )
+               { bits.set(bits.index(pos.getX(), pos.getY()), Stone::WhiteStone == stone); }, m_BitBoard);
+
+    m_Hash ^= Zobrist::stoneKey(pos, Stone::WhiteStone == stone);
+
+    const int weight { EvalWeights::fieldWeight(pos, m_BoardSize) };
+
+    if( Stone::WhiteStone == stone ) { ++m_WhiteStones; m_Positional += weight; }
+    else                             { ++m_BlackStones; m_Positional -= weight; }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -131,10 +150,15 @@ void Reversi::removeStone( const Pos_Vect& pos )
     Stone stone = m_Board.peekField(pos);
     m_Board.setToField(pos, Stone::NoStone);
 
+    std::visit([&pos]( auto& bits ) { bits.remove(bits.index(pos.getX(), pos.getY())); }, m_BitBoard);
+
+    const int weight { EvalWeights::fieldWeight(pos, m_BoardSize) };
+
     switch( stone ) {
-    case Stone::WhiteStone : --m_WhiteStones; break;
-    case Stone::BlackStone : --m_BlackStones; break;
-    case Stone::NoStone    : break;
+    case Stone::WhiteStone : --m_WhiteStones; m_Hash ^= Zobrist::stoneKey(pos, true);  m_Positional -= weight; break;
+    case Stone::BlackStone : --m_BlackStones; m_Hash ^= Zobrist::stoneKey(pos, false); m_Positional += weight; break;
+    case Stone::NoStone    :
+    case Stone::OffBoard   : break;
     }
 }
 
@@ -144,17 +168,25 @@ void Reversi::flipStone( const Pos_Vect& pos )
 {
     const Stone stone { m_Board.peekField(pos) };
 
+    std::visit([&pos]( auto& bits ) { bits.flip(bits.index(pos.getX(), pos.getY())); }, m_BitBoard);
+
+    m_Hash ^= Zobrist::stoneKey(pos, true) ^ Zobrist::stoneKey(pos, false);
+
+    const int weight { 2 * EvalWeights::fieldWeight(pos, m_BoardSize) };
+
     if( Stone::WhiteStone == stone )
     {
         m_Board.setToField(pos, Stone::BlackStone);
         --m_WhiteStones;
         ++m_BlackStones;
+        m_Positional -= weight;
     }
     else
     {
         m_Board.setToField(pos, Stone::WhiteStone);
         --m_BlackStones;
         ++m_WhiteStones;
+        m_Positional += weight;
     }
 }
 
@@ -164,37 +196,93 @@ FieldList Reversi::getValidMoves( const Stone stone )
 {
     FieldList validMoves {};
 
-    for( int x { 0 }; x < m_BoardSize; ++x )
+    getValidMoves(stone, validMoves);
+
+    return validMoves;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Reversi::getValidMoves( const Stone stone, FieldList& validMoves )
+{
+    generateValidMoves(stone, validMoves);
+
+    setValidMoveNum(stone, static_cast<int>(validMoves.size()));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int Reversi::getMoveCount( const Stone stone ) const
+{
+    const bool white { Stone::WhiteStone == stone };
+
+    return std::visit([white]( const auto& bits ) { return BitOps::popCount(bits.getMoves(white)); }, m_BitBoard);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int Reversi::getPotentialMobility( const Stone stone ) const
+{
+    const bool white { Stone::WhiteStone == stone };
+
+    return std::visit([white]( const auto& bits ) { return BitOps::popCount(bits.getAdjacent(!white)); }, m_BitBoard);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Reversi::makeMove( const FieldValue& move, const Stone stone )
+{
+    setStone(move.getFieldPosition(), stone);
+
+    for( const auto& pos : move )
     {
-        for( int y { 0 }; y < m_BoardSize; ++y )
-        {
-            Pos_Vect        curPos { x, y };
-            Reversi::Stone  curStone { m_Board.peekField(curPos) };
-
-            if( Reversi::Stone::NoStone == curStone )                       // moves are only valid for EMPTY fields
-            {
-                FieldValue fv{curPos};
-
-                for( const auto& curDir : m_Directions )                    // go through all directions
-                {
-                    FieldValue n = checkNeighbor(curPos, curDir, stone);    // and check neighbor in that direction
-
-                    if( n.getValue() )                                      // flips available?
-                    {
-                        fv += n;                                            // add them to the result
-                    }
-                }
-
-                if( fv.getValue() > 0 ) {                                   // if "flippables", add position to the list
-                    validMoves.push_back(fv);
-                }
-            }
-        }
+        flipStone(pos);
     }
+}
 
-    setValidMoveNum(stone, static_cast<int>(validMoves.size()));
+// ---------------------------------------------------------------------------------------------------------------------
 
-    return validMoves;
+void Reversi::undoMove( const FieldValue& move )
+{
+    for( const auto& pos : move )
+    {
+        flipStone(pos);
+    }
+
+    removeStone(move.getFieldPosition());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Reversi::generateValidMoves( const Stone stone, FieldList& validMoves ) const
+{
+    const bool  white { Stone::WhiteStone == stone };
+
+    validMoves.clear();
+
+    std::visit([&validMoves, white]( const auto& bits )
+               {
+                   const int   siz { bits.m_Size };
+                   auto        moves { bits.getMoves(white) };
+
+                   while( moves )                                           // ascending bits, same order as the scan
+                   {
+                       const int   idx { BitOps::lowestIndex(moves) };
+                       auto        flips { bits.getFlips(idx, white) };
+                       FieldValue  fv { { idx / siz, idx % siz } };
+
+                       while( flips )
+                       {
+                           const int flipIdx { BitOps::lowestIndex(flips) };
+
+                           fv.addValuePosition({ flipIdx / siz, flipIdx % siz });
+                           flips = BitOps::clearLowest(flips);
+                       }
+                       validMoves.push_back(fv);
+
+                       moves = BitOps::clearLowest(moves);
+                   }
+               }, m_BitBoard);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -25,6 +25,9 @@
 #include "FieldValue.h"
 #include "FieldList.h"
 #include "QuadraticBoard.h"
+#include "BitBoard.h"
+#include "Zobrist.h"
+#include "EvalWeights.h"
 
 // =====================================================================================================================
 
@@ -34,9 +37,12 @@
  *
  * It contains
  * - a board
+ * - a bit-board copy of the position, instantiated for the board size, used for fast move generation
  * - the definition of valid directions for moves (to check if opposite stones can be catured regarding that direction)
  * - the last number of possible moves per player (to chek if the game is over)
  * - the number of white / black stones on the board
+ * - a Zobrist hash of the position, updated with every change of a stone
+ * - the sum of the field weights of the stones (see EvalWeights), also updated with every change of a stone
  *
  * here we have functions to
  * - check if the game is over
@@ -55,13 +61,15 @@ public:
 
     /*! type of stones used to play, for easier handling "no stone" is also used here
      * so that we assume that each cell/field of the board initially has a "no stone"
-     * type which can be exchanged by another type of stone.
+     * type which can be exchanged by another type of stone. "off board" is only found
+     * on the border cells surrounding the board, it stops walking along a direction.
      */
     enum class Stone
     {
         BlackStone,
         NoStone,
-        WhiteStone
+        WhiteStone,
+        OffBoard
     };
 
     // =================================================================================================================
@@ -129,12 +137,46 @@ public:
 
     /*! @brief get a complete list of all valid moves for a color at a certain state of the game
      * @details returns a list of "FieldValues", containing the position of the move and the list
-     * of positions of stones that will be flipped if the move is choosen.
+     * of positions of stones that will be flipped if the move is choosen. The moves are generated via the bit-board.
      * @param stone     stone color to check
      * @return          list of valid moves (positions to place that stone)
      */
     FieldList getValidMoves( const Stone stone );
 
+    /*! @brief get a complete list of all valid moves, filling a list supplied by the caller
+     *
+     * @param stone         stone color to check
+     * @param validMoves    list to fill, previous content is dropped
+     */
+    void getValidMoves( const Stone stone, FieldList& validMoves );
+
+    /*! @brief get the number of valid moves for a color, without building the list
+     *
+     * @param stone         stone color to check
+     * @return              number of valid moves
+     */
+    int getMoveCount( const Stone stone ) const;
+
+    /*! @brief get the potential mobility of a color: the number of empty fields next to the opponent's stones
+     *
+     * @param stone         stone color to check
+     * @return              number of fields
+     */
+    int getPotentialMobility( const Stone stone ) const;
+
+    /*! @brief make a move: put the stone on the field of the move and flip all captured stones
+     *
+     * @param move      move taken from the list of valid moves
+     * @param stone     stone to place
+     */
+    void makeMove( const FieldValue& move, const Stone stone );
+
+    /*! @brief undo a move done via makeMove()
+     *
+     * @param move      the same move
+     */
+    void undoMove( const FieldValue& move );
+
     /*! @brief copy constructor
      *
      * @param other     game to copy
@@ -168,6 +210,36 @@ public:
      */
     int getBoardSize() const
     { return m_BoardSize * m_BoardSize; }
+
+    /*! @brief get the number of rows / coloumns
+     *
+     * @return      size as given to the constructor
+     */
+    int getSize() const
+    { return m_BoardSize; }
+
+    /*! @brief get the Zobrist hash of the stones on the board, the side to move is not included
+     *
+     * @return      hash value
+     */
+    uint64_t getHash() const
+    { return m_Hash; }
+
+    /*! @brief get the bit-board of the stones, for fast analysis of a position
+     *
+     * @return      bit-board of the size of the board
+     */
+    const AnyBitBoard& getBitBoard() const
+    { return m_BitBoard; }
+
+    /*! @brief get the positional score: field weights of the own stones minus the ones of the opponent
+     *
+     * @param stone     stone color to score
+     * @return          score
+     */
+    int getPositional( const Stone stone ) const
+    { return Stone::WhiteStone == stone ? m_Positional : -m_Positional; }
+
 protected:
 
     /*! @brief check neigbours of a stone regarding a certain direction, returning a list of positions
@@ -180,6 +252,13 @@ protected:
      */
     FieldValue checkNeighbor( const Pos_Vect toCheck, const Pos_Vect direction, const Stone stone ) const;
 
+    /*! @brief get all valid moves via shift-and-mask on the bit-board
+     *
+     * @param stone         stone / color to check
+     * @param validMoves    list of valid moves
+     */
+    void generateValidMoves( const Stone stone, FieldList& validMoves ) const;
+
     /*! @brief store number of possible moves for a particular player (stone) - needed to check if game is over
      *
      * @param stone         stone / color
@@ -198,9 +277,12 @@ private:
 
     int                             m_BoardSize;                            ///< actual size of the board (4...10)
     QuadraticBoard<Stone>           m_Board;                                ///< the logical board
+    AnyBitBoard                     m_BitBoard;                             ///< same position as bits
 
     int                             m_WhiteStones { 0 };                    ///< total number of white stones on the board
     int                             m_BlackStones { 0 };                    ///<                 black
+    uint64_t                        m_Hash { 0 };                           ///< Zobrist hash of the stones
+    int                             m_Positional { 0 };                     ///< field weights white minus black
 
     // Allowed directions for "capturing" stones, if you simply remove the "intermediate" directions like north-east ...
     // you will get a simpler version of the game.
@@ -0,0 +1,888 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include "SearchEngine.h"
+#include "EndgameSolver.h"
+
+// =====================================================================================================================
+
+SearchEngine::SearchEngine( const Reversi& position, const size_t hashSizeMB )
+    : m_reversi { position }
+    , m_MoveStack( m_MaxPly )
+    , m_OrderKeys( m_MaxPly )
+    , m_Killers( m_MaxPly )
+    , m_TransTable { std::make_shared<TranspositionTable>(hashSizeMB) }
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+SearchEngine::SearchEngine( const Reversi& position, const std::shared_ptr<TranspositionTable>& transTable,
+                            std::atomic<bool>& stop )
+    : m_reversi { position }
+    , m_MoveStack( m_MaxPly )
+    , m_OrderKeys( m_MaxPly )
+    , m_Killers( m_MaxPly )
+    , m_TransTable { transTable }
+    , m_Stop { &stop }
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SearchEngine::setThreads( const int numThreads )
+{
+    const int numHelpers { std::max(numThreads, 1) - 1 };
+
+    if( numHelpers == static_cast<int>(m_Helpers.size()) )
+        return;
+
+    m_Pool.reset();                                                                 // stop the old threads first
+    m_Scheduler.reset();
+    m_Helpers.clear();
+
+    for( int i { 0 }; i < numHelpers; ++i )
+    {
+        m_Helpers.emplace_back(new SearchEngine(m_reversi, m_TransTable, m_stopCalculation));
+        m_Helpers.back()->m_WorkerId = i + 1;
+    }
+
+    if( numHelpers > 0 )
+    {
+        m_Pool      = std::make_unique<ThreadPool>(numHelpers + 1);
+        m_Scheduler = std::make_unique<SplitScheduler>(numHelpers + 1);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t SearchEngine::getHashKey( const Reversi::Stone stone ) const
+{
+    return Reversi::Stone::WhiteStone == stone ? m_reversi.getHash() ^ Zobrist::sideKey() : m_reversi.getHash();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SearchEngine::startSearch( const std::chrono::steady_clock::time_point deadline )
+{
+    m_NodeCount      = 0;
+    m_PublishedNodes = 0;
+    m_Deadline       = deadline;
+
+    for( auto& killers : m_Killers )                                                // killers belong to a position,
+        killers.fill(TranspositionTable::m_NoMove);                                 //      the history is aged only
+    for( auto& history : m_History )
+        for( auto& count : history )
+            count >>= 1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int SearchEngine::packMove( const Pos_Vect& pos )
+{
+    return ( pos.getX() << 4 ) | pos.getY();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TranspositionTable::Bound SearchEngine::getBound( const int score, const int alpha, const int beta )
+{
+    if( score <= alpha ) return TranspositionTable::Bound::Upper;
+    if( score >= beta )  return TranspositionTable::Bound::Lower;
+    return TranspositionTable::Bound::Exact;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SearchEngine::probeTable( const uint64_t key, const int depth, const int alpha, const int beta, int& score,
+                               int& hashMove ) const
+{
+    TranspositionTable::Entry entry {};
+
+    hashMove = TranspositionTable::m_NoMove;
+
+    if( !m_TransTable->probe(key, entry) )
+        return false;
+
+    hashMove = entry.move;                                                          // good to search first, even if
+
+    if( entry.depth < depth )                                                       //      not deep enough
+        return false;
+
+    switch( entry.bound )
+    {
+    case TranspositionTable::Bound::Exact : break;
+    case TranspositionTable::Bound::Lower : if( entry.score < beta )  return false; break;
+    case TranspositionTable::Bound::Upper : if( entry.score > alpha ) return false; break;
+    case TranspositionTable::Bound::None  : return false;
+    }
+
+    score = entry.score;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// order: hash move, killer moves, then by history - ties (and moves never causing a cut-off) are broken by the number
+// of moves left to the opponent, the fewer the better
+
+void SearchEngine::orderMoves( const Reversi::Stone stone, const int depth, const int ply, const int hashMove )
+{
+    FieldList&      moves { m_MoveStack[ply] };
+    OrderKeys&      keys { m_OrderKeys[ply] };
+    const Killers&  killers { m_Killers[ply] };
+    const auto&     history { m_History[Reversi::Stone::WhiteStone == stone] };
+    const bool      mobility { depth >= m_MobilityDepth && moves.size() > 1 };
+
+    for( size_t i { 0 }; i < moves.size(); ++i )
+    {
+        const int move { packMove(moves[i].getFieldPosition()) };
+
+        if( move == hashMove )
+            keys[i] = m_HashMoveKey;
+        else if( move == killers[0] )
+            keys[i] = m_KillerKey;
+        else if( move == killers[1] )
+            keys[i] = m_KillerKey - 1;
+        else
+        {
+            int key { history[move] << 7 };
+
+            if( mobility )
+            {
+                m_reversi.makeMove(moves[i], stone);
+                key += FieldList::m_MaxFields - m_reversi.getMoveCount(Reversi::otherColor(stone));
+                m_reversi.undoMove(moves[i]);
+            }
+
+            keys[i] = std::min(key, m_KillerKey - 2);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SearchEngine::selectMove( const int ply, const int first )
+{
+    FieldList&  moves { m_MoveStack[ply] };
+    OrderKeys&  keys { m_OrderKeys[ply] };
+    int         best { first };
+
+    for( int i { first + 1 }; i < static_cast<int>(moves.size()); ++i )
+        if( keys[i] > keys[best] )
+            best = i;
+
+    if( best != first )
+    {
+        std::swap(moves[first], moves[best]);
+        std::swap(keys[first], keys[best]);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SearchEngine::storeCutoff( const Reversi::Stone stone, const int depth, const int ply, const int move )
+{
+    Killers&    killers { m_Killers[ply] };
+    int&        history { m_History[Reversi::Stone::WhiteStone == stone][move] };
+
+    if( killers[0] != move )
+    {
+        killers[1] = killers[0];
+        killers[0] = move;
+    }
+
+    history = std::min(history + depth * depth, m_KillerKey >> 8);                  // keep clear of the killer keys
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SearchEngine::loadPatterns( const std::string& path )
+{
+    auto patterns { std::make_shared<PatternEvaluator>() };
+
+    if( patterns->load(path) )
+        m_Patterns = patterns;
+    else
+        m_Patterns.reset();
+
+    return nullptr != m_Patterns;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SearchEngine::loadBook( const std::string& path )
+{
+    auto book { std::make_unique<OpeningBook>() };
+
+    if( book->load(path, m_reversi.getSize()) )
+        m_Book = std::move(book);
+    else
+        m_Book.reset();
+
+    return nullptr != m_Book;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SearchEngine::loadDatabase( const std::string& path )
+{
+    auto database { std::make_unique<PerfectPlayDB>() };
+
+    if( m_reversi.getSize() <= 6 && database->load(path, m_reversi.getSize()) )
+        m_Database = std::move(database);
+    else
+        m_Database.reset();
+
+    return nullptr != m_Database;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SearchEngine::probeDatabase( const Reversi::Stone stone, MoveInfo& info )
+{
+    const FieldList&        moves { m_MoveStack[0] };
+    const Reversi::Stone    other { Reversi::otherColor(stone) };
+    int                     bestScore { -m_Infinity };
+    MoveInfo                best { info };
+
+    for( int i { 0 }; i < static_cast<int>(moves.size()); ++i )
+    {
+        int score { 0 };
+
+        m_reversi.makeMove(moves[i], stone);
+        const bool found { m_Database->probe(PerfectPlayDB::canonicalKey(m_reversi, other), score) };
+        m_reversi.undoMove(moves[i]);
+
+        if( !found )                                                                // every move has to be known
+            return false;
+
+        if( -score > bestScore )
+        {
+            bestScore = -score;
+            best      = { moves[i].getFieldPosition(), i, toFinalScore(bestScore),
+                          m_reversi.getBoardSize() - m_reversi.getWhiteNum() - m_reversi.getBlackNum(), 0 };
+        }
+    }
+    info = best;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int SearchEngine::evaluate( const Reversi::Stone stone ) const
+{
+    if( m_Patterns && PatternEvaluator::m_BoardSize == m_reversi.getSize() )
+    {
+        const auto& bits { std::get<BitBoard<PatternEvaluator::m_BoardSize>>(m_reversi.getBitBoard()) };
+        const bool  white { Reversi::Stone::WhiteStone == stone };
+
+        return std::clamp(m_Patterns->evaluate(bits.getStones(white), bits.getStones(!white)),
+                          -m_WinScore + 1, m_WinScore - 1);                         // below any finished game
+    }
+
+    const Reversi::Stone        other { Reversi::otherColor(stone) };
+    const EvalWeights::Terms&   terms { EvalWeights::terms(m_reversi.getSize()) };
+    const int                   emptyFields { m_reversi.getBoardSize() - m_reversi.getWhiteNum()
+                                              - m_reversi.getBlackNum() };
+
+    return m_reversi.getPositional(stone)
+         + terms.mobility  * ( m_reversi.getMoveCount(stone) - m_reversi.getMoveCount(other) )
+         + terms.potential * ( m_reversi.getPotentialMobility(stone) - m_reversi.getPotentialMobility(other) )
+         + ( emptyFields & 1 ? terms.parity : -terms.parity );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+SearchEngine::MoveInfo SearchEngine::computeNextMove( const Reversi::Stone stone, const int depth,
+                                                      const int timeLimitMs )
+{
+    MoveInfo    ret { {-1, -1}, -1 };
+    FieldList&  moves { m_MoveStack[0] };
+
+    m_stopCalculation = false;                                                      // assume to keep working
+    m_TransTable->newSearch();
+
+    startSearch(timeLimitMs > 0
+                ? std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMs)
+                : std::chrono::steady_clock::time_point::max());
+
+    m_reversi.getValidMoves(stone, moves);                                          // get possible moves, just once
+
+    const int validMoves { static_cast<int>(moves.size()) };                        // get number of possible moves
+    const int emptyFields { m_reversi.getBoardSize() - m_reversi.getWhiteNum() - m_reversi.getBlackNum() };
+    const int maxDepth { std::min({ depth, m_MaxPly - 1, emptyFields }) };          // no need to look beyond the end
+
+    if( !validMoves )
+        return ret;
+
+    OpeningBook::Entry bookEntry {};
+
+    if( m_Book && m_Book->probe(getHashKey(stone), bookEntry) )                     // known opening: no need to search
+        for( int i { 0 }; i < validMoves; ++i )
+            if( packMove(moves[i].getFieldPosition()) == bookEntry.move )
+                return { moves[i].getFieldPosition(), i, bookEntry.score, bookEntry.depth, 0 };
+
+    if( m_Database && probeDatabase(stone, ret) )                                   // small board: known exactly
+        return ret;
+
+    ret.pos = moves[0].getFieldPosition();                                          // something to play, even if not
+    ret.idx = 0;                                                                    //      even depth 1 completes
+
+    std::iota(m_RootOrder.begin(), m_RootOrder.begin() + validMoves, 0);
+
+    TranspositionTable::Entry entry {};                                             // start with the best move of a
+
+    if( m_TransTable->probe(getHashKey(stone), entry) )                             //      previous computation
+        for( int i { 0 }; i < validMoves; ++i )
+            if( packMove(moves[i].getFieldPosition()) == entry.move )
+            {
+                std::rotate(m_RootOrder.begin(), m_RootOrder.begin() + i, m_RootOrder.begin() + i + 1);
+                break;
+            }
+
+    for( auto& helper : m_Helpers )                                                 // same position, list and order of
+    {                                                                               //      moves and settings for all
+        helper->m_reversi            = m_reversi;                                  //      helpers
+        helper->m_Patterns           = m_Patterns;
+        helper->m_EndgameEmpties     = m_EndgameEmpties;
+        helper->m_EndgameWinLossDraw = m_EndgameWinLossDraw;
+        helper->m_Algorithm          = m_Algorithm;
+        helper->startSearch(m_Deadline);
+        helper->m_reversi.getValidMoves(stone, helper->m_MoveStack[0]);
+        helper->m_RootOrder = m_RootOrder;
+    }
+
+    if( !m_Helpers.empty() && ParallelMode::LazySMP == m_ParallelMode )
+    {
+        const MoveInfo start { ret };
+
+        m_Pool->run([this, stone, maxDepth, &ret, &start]( const int worker )
+                    {
+                        if( 0 == worker )
+                        {
+                            deepen(stone, maxDepth, 1, ret);
+                            m_stopCalculation = true;                               // done, stop the helpers
+                        }
+                        else
+                        {
+                            MoveInfo helperRet { start };                           // every other helper one ply
+                            m_Helpers[worker - 1]->deepen(stone, maxDepth, 1 + ( worker & 1 ), helperRet);
+                        }
+                    });
+    }
+    else if( !m_Helpers.empty() && ParallelMode::YBWC == m_ParallelMode )
+    {
+        m_Scheduler->m_Done = false;
+        m_SplitScheduler    = m_Scheduler.get();
+
+        for( auto& helper : m_Helpers )
+            helper->m_SplitScheduler = m_SplitScheduler;
+
+        m_Pool->run([this, stone, maxDepth, &ret]( const int worker )
+                    {
+                        if( 0 == worker )
+                        {
+                            deepen(stone, maxDepth, 1, ret);
+                            m_SplitScheduler->m_Done = true;                        // done, let the helpers go
+                        }
+                        else
+                            m_Helpers[worker - 1]->helpSearch();
+                    });
+
+        m_SplitScheduler = nullptr;
+
+        for( auto& helper : m_Helpers )
+            helper->m_SplitScheduler = nullptr;
+    }
+    else
+        deepen(stone, maxDepth, 1, ret);
+
+    ret.nodes = m_NodeCount;
+
+    for( const auto& helper : m_Helpers )
+        ret.nodes += helper->m_NodeCount;
+
+    return ret;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SearchEngine::getHashMove( const Reversi::Stone stone, Pos_Vect& pos ) const
+{
+    TranspositionTable::Entry entry {};
+
+    if( !m_TransTable->probe(getHashKey(stone), entry) || TranspositionTable::m_NoMove == entry.move )
+        return false;
+
+    pos = { entry.move >> 4, entry.move & 0xf };                                    // see packMove()
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// iterative deepening: search depth 1, 2, ... until the depth limit is reached or the time is up, the best move of an
+// iteration is searched first by the next one
+
+void SearchEngine::deepen( const Reversi::Stone stone, const int maxDepth, const int firstDepth, MoveInfo& ret )
+{
+    const FieldList&    moves { m_MoveStack[0] };
+    const int           validMoves { static_cast<int>(moves.size()) };
+    const bool          splitRoot { !m_Helpers.empty() && ParallelMode::RootSplit == m_ParallelMode };
+    const int           emptyFields { m_reversi.getBoardSize() - m_reversi.getWhiteNum() - m_reversi.getBlackNum() };
+    const bool          solvable { maxDepth == emptyFields && emptyFields <= m_EndgameEmpties };
+
+    // if the end can be reached, a few shallow iterations give a move in case the time is up - then the position is
+    // solved right away, deeper iterations of the generic search would take about as long as the solver
+    for( int curDepth { firstDepth }; curDepth <= maxDepth;
+         curDepth = solvable && curDepth >= m_EndgamePrepDepth ? std::max(curDepth + 1, maxDepth) : curDepth + 1 )
+    {
+        int         bestIdx { -1 };
+        int         score { 0 };
+
+        if( solvable && m_EndgameWinLossDraw && curDepth == maxDepth )
+            score = searchRoot(stone, curDepth, -1, 1, bestIdx);                    // just win, loss or draw
+        else if( splitRoot && validMoves > 1 )
+            score = searchRootParallel(stone, curDepth, bestIdx);
+        else if( Algorithm::MTDf == m_Algorithm )
+            score = searchMTDf(stone, curDepth, ret.score, bestIdx);
+        else
+            score = searchRoot(stone, curDepth, -m_Infinity, m_Infinity, bestIdx);
+
+        if( *m_Stop || bestIdx < 0 )                                                // incomplete iteration, use the
+            break;                                                                  //      result of the previous one
+
+        ret.pos   = moves[bestIdx].getFieldPosition();
+        ret.idx   = bestIdx;
+        ret.score = score;
+        ret.depth = curDepth;
+        ret.nodes = countNodes();                                                   // the helpers' as well
+
+        if( m_Progress )
+            m_Progress(ret);
+
+        const auto best { std::find(m_RootOrder.begin(), m_RootOrder.begin() + validMoves, bestIdx) };
+
+        std::rotate(m_RootOrder.begin(), best, best + 1);                           // best first for the next one
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// the root is not taken from the transposition table, the best move has to be known - its moves are searched in the
+// order of m_RootOrder, the list itself keeps the order the caller knows
+
+int SearchEngine::searchRoot( const Reversi::Stone stone, const int depth, const int alpha, const int beta,
+                              int& bestIdx )
+{
+    const FieldList&        moves { m_MoveStack[0] };
+    const Reversi::Stone    other { Reversi::otherColor(stone) };
+    int                     bestScore { -m_Infinity };
+    int                     bestMove { TranspositionTable::m_NoMove };
+    int                     curAlpha { alpha };
+
+    for( int i { 0 }; i < static_cast<int>(moves.size()); ++i )
+    {
+        if( *m_Stop ) break;
+
+        const int idx { m_RootOrder[i] };
+
+        m_reversi.makeMove(moves[idx], stone);
+
+        int score { 0 };
+
+        if( 0 == i )
+            score = -negaMax(other, depth - 1, -beta, -curAlpha, 1);
+        else
+        {
+            score = -negaMax(other, depth - 1, -curAlpha - 1, -curAlpha, 1);        // prove it is not better
+            if( score > curAlpha && score < beta )
+                score = -negaMax(other, depth - 1, -beta, -curAlpha, 1);            // it is, get the exact score
+        }
+
+        m_reversi.undoMove(moves[idx]);
+
+        if( *m_Stop ) break;                                                        // score of an incomplete search
+
+        if( score > bestScore )
+        {
+            bestScore = score;
+            bestIdx   = idx;
+            bestMove  = packMove(moves[idx].getFieldPosition());
+        }
+
+        curAlpha = std::max(curAlpha, bestScore);
+
+        if( curAlpha >= beta )
+            break;
+    }
+
+    if( !*m_Stop )
+        m_TransTable->store(getHashKey(stone), depth, bestScore, getBound(bestScore, alpha, beta), bestMove);
+
+    return bestScore;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int SearchEngine::searchRootParallel( const Reversi::Stone stone, const int depth, int& bestIdx )
+{
+    const FieldList&        moves { m_MoveStack[0] };
+    const int               first { m_RootOrder[0] };
+
+    m_reversi.makeMove(moves[first], stone);                                        // the best move so far alone, its
+
+    const int firstScore { -negaMax(Reversi::otherColor(stone), depth - 1, -m_Infinity, m_Infinity, 1) };
+
+    m_reversi.undoMove(moves[first]);                                               //      score bounds all others
+
+    if( *m_Stop )
+        return firstScore;
+
+    std::atomic<int>        next { 1 };
+    std::atomic<int64_t>    best { packRootScore(firstScore, 0) };
+
+    m_Pool->run([this, stone, depth, &next, &best]( const int worker )
+                {
+                    SearchEngine& engine { 0 == worker ? *this : *m_Helpers[worker - 1] };
+                    engine.searchRootMoves(stone, depth, m_RootOrder, next, best);
+                });
+
+    const int score { unpackRootScore(best) };
+
+    bestIdx = m_RootOrder[unpackRootPos(best)];
+
+    if( !*m_Stop )
+        m_TransTable->store(getHashKey(stone), depth, score, TranspositionTable::Bound::Exact,
+                           packMove(moves[bestIdx].getFieldPosition()));
+
+    return score;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SearchEngine::searchRootMoves( const Reversi::Stone stone, const int depth, const OrderKeys& order,
+                                    std::atomic<int>& next, std::atomic<int64_t>& best )
+{
+    const FieldList&        moves { m_MoveStack[0] };
+    const Reversi::Stone    other { Reversi::otherColor(stone) };
+
+    for( int i { next++ }; i < static_cast<int>(moves.size()) && !*m_Stop; i = next++ )
+    {
+        const int       idx { order[i] };
+        const int64_t   current { best };
+        const int       bound { unpackRootScore(current) - ( i < unpackRootPos(current) ? 1 : 0 ) };
+
+        m_reversi.makeMove(moves[idx], stone);
+
+        int score { -negaMax(other, depth - 1, -bound - 1, -bound, 1) };            // prove it is not better
+
+        if( score > bound )
+            score = -negaMax(other, depth - 1, -m_Infinity, -bound, 1);             // it is, get the exact score
+
+        m_reversi.undoMove(moves[idx]);
+
+        if( *m_Stop || score <= bound )
+            continue;
+
+        const int64_t   packed { packRootScore(score, i) };
+        int64_t         expected { best };
+
+        while( packed > expected && !best.compare_exchange_weak(expected, packed) )
+            ;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// the tasks are pushed with the most promising move on top, so the thread takes them in the same order as a
+// sequential search - as long as they are not stolen. While waiting for the stolen ones, only tasks of nodes below
+// this one are taken: they are searched at the plies of their own nodes, above this ply on the move stack, and each of
+// them helps to get this node done.
+
+void SearchEngine::splitNode( const Reversi::Stone stone, const int depth, const int alpha, const int beta,
+                              const int ply, int& bestScore, int& bestMove )
+{
+    FieldList&  moves { m_MoveStack[ply] };
+    TaskQueue&  queue { m_SplitScheduler->m_Queues[m_WorkerId] };
+    SplitPoint  split { m_reversi, stone, depth, ply, alpha, beta, bestScore, bestMove, m_ActiveSplit };
+
+    for( int i { 1 }; i < static_cast<int>(moves.size()); ++i )                     // the young brothers, in order
+    {
+        selectMove(ply, i);
+        split.m_Moves.push_back(moves[i]);
+    }
+
+    const int numTasks { static_cast<int>(split.m_Moves.size()) };
+
+    split.m_Unfinished = numTasks;
+
+    for( int i { numTasks - 1 }; i >= 0; --i )
+        queue.push({ &split, i });
+
+    SplitTask task {};
+
+    while( split.m_Unfinished > 0 )
+    {
+        if( queue.pop(task, &split) || stealTask(task, &split) )
+            runTask(task);
+        else
+            std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> lock { split.m_Mutex };
+
+    bestScore = split.m_BestScore;
+    bestMove  = split.m_BestMove;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SearchEngine::runTask( const SplitTask& task )
+{
+    SplitPoint& split { *task.m_Split };
+    const int   ply { split.m_Ply + 1 };                                            // the killers of the thread are
+                                                                                    //      kept per ply from the root
+
+    if( !*m_Stop && !split.cancelled() )
+    {
+        const Reversi           saved { m_reversi };                                // the position of the node of this
+        const SplitPoint*       outer { m_ActiveSplit };                            //      thread, if any
+        const FieldValue&       move { split.m_Moves[task.m_Move] };
+        const Reversi::Stone    other { Reversi::otherColor(split.m_Stone) };
+        const int               alpha { split.m_Alpha };
+
+        m_reversi     = split.m_Position;
+        m_ActiveSplit = &split;
+
+        m_reversi.makeMove(move, split.m_Stone);
+
+        int score { -negaMax(other, split.m_Depth - 1, -alpha - 1, -alpha, ply) };   // prove it is not better
+
+        if( score > alpha && score < split.m_Beta )
+            score = -negaMax(other, split.m_Depth - 1, -split.m_Beta, -alpha, ply);  // it is, get the exact score
+
+        const int packed { packMove(move.getFieldPosition()) };
+
+        if( !*m_Stop && !split.cancelled() && split.update(score, packed) )
+            storeCutoff(split.m_Stone, split.m_Depth, split.m_Ply, packed);
+
+        m_ActiveSplit = outer;
+        m_reversi     = saved;
+    }
+
+    --split.m_Unfinished;                                                           // the split node may be gone now
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool SearchEngine::stealTask( SplitTask& task, const SplitPoint* subtree )
+{
+    const int numWorkers { m_SplitScheduler->m_NumWorkers };
+
+    for( int i { 1 }; i < numWorkers; ++i )                                         // the next one first, so not all
+    {                                                                               //      thieves try the same queue
+        if( m_SplitScheduler->m_Queues[( m_WorkerId + i ) % numWorkers].steal(task, subtree) )
+            return true;
+    }
+
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SearchEngine::helpSearch()
+{
+    SplitTask task {};
+
+    while( !m_SplitScheduler->m_Done )
+    {
+        if( stealTask(task, nullptr) )
+            runTask(task);
+        else
+            std::this_thread::yield();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// the scores are integers, so a null window (beta - 1, beta) tells whether the score is below beta or not - the bounds
+// move towards each other until they meet, the best move is the one of the last search failing high
+
+int SearchEngine::searchMTDf( const Reversi::Stone stone, const int depth, const int guess, int& bestIdx )
+{
+    int score { guess };
+    int lower { -m_Infinity };
+    int upper { m_Infinity };
+
+    while( lower < upper && !*m_Stop )
+    {
+        const int   beta { score == lower ? score + 1 : score };
+        int         idx { -1 };
+
+        score = searchRoot(stone, depth, beta - 1, beta, idx);
+
+        if( score < beta )
+            upper = score;
+        else
+        {
+            lower   = score;
+            bestIdx = idx;
+        }
+    }
+
+    return score;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+int SearchEngine::solveEndgame( const Reversi::Stone stone, const int alpha, const int beta )
+{
+    static_assert(1 == toDiscBound(m_WinScore + 1) && 0 == toDiscBound(m_WinScore)                // around a won
+                  && 0 == toDiscBound(m_WinScore - 1) && 1 == -toDiscBound(-m_WinScore)             //      and a lost
+                  && -1 == toDiscBound(-m_WinScore + 1) && -1 == toDiscBound(-m_WinScore)           //      game
+                  && -1 == toDiscBound(-m_WinScore - 1) && -2 == toDiscBound(-m_WinScore - 2),
+                  "a bound has to keep the disc differences of the scores within the window");
+
+    const bool  white { Reversi::Stone::WhiteStone == stone };
+    int         bestIdx { -1 };
+
+    return std::visit([this, white, alpha, beta, &bestIdx]( const auto& bits )
+                      {
+                          EndgameSolver<std::decay_t<decltype(bits)>::m_Size> solver {
+                              *m_Stop, m_Deadline, [this]() { return cancelled(); } };
+
+                          const int discs { solver.solve(bits.getStones(white), bits.getStones(!white),
+                                                         toDiscBound(alpha), -toDiscBound(-beta), bestIdx) };
+
+                          if( solver.isCancelled() )                                // a sibling's cut-off: thrown
+                              return 0;                                             //      away, not counted
+
+                          m_NodeCount += solver.getNodeCount();
+                          return toFinalScore(discs);
+                      }, m_reversi.getBitBoard());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SearchEngine::checkTime()
+{
+    if( 0 == ( ++m_NodeCount & m_TimeCheckMask ) )
+    {
+        m_PublishedNodes.store(m_NodeCount, std::memory_order_relaxed);
+
+        if( std::chrono::steady_clock::now() >= m_Deadline )
+            *m_Stop = true;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+uint64_t SearchEngine::countNodes() const
+{
+    uint64_t nodes { m_NodeCount };
+
+    for( const auto& helper : m_Helpers )
+        nodes += helper->m_PublishedNodes.load(std::memory_order_relaxed);
+
+    return nodes;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// a pass doesn't count as a ply of the move stack: the list of the passing player is empty and not needed any more,
+// so the opponent's moves can use the same slot - the ply never gets larger than the depth of the search
+
+int SearchEngine::negaMax( const Reversi::Stone stone, const int depth, int alpha, const int beta, const int ply,
+                           const bool passed )
+{
+    checkTime();
+
+    const int emptyFields { m_reversi.getBoardSize() - m_reversi.getWhiteNum() - m_reversi.getBlackNum() };
+
+    if( depth >= emptyFields && emptyFields <= m_EndgameEmpties )                   // the end is in reach: solve it
+        return solveEndgame(stone, alpha, beta);
+
+    if( depth <= 0 )
+        return evaluate(stone);
+
+    const uint64_t  key { getHashKey(stone) };
+    int             stored { 0 };
+    int             hashMove { TranspositionTable::m_NoMove };
+
+    if( probeTable(key, depth, alpha, beta, stored, hashMove) )                     // analyzed before?
+        return stored;
+
+    FieldList&  moves { m_MoveStack[ply] };                                         // list of this ply, filled once
+
+    m_reversi.getValidMoves(stone, moves);
+
+    if( 0 == moves.size() )
+        return passed
+               ? getFinalScore(stone)                                               // nobody can move: game over
+               : -negaMax(Reversi::otherColor(stone), depth, -beta, -alpha, ply, true);
+
+    orderMoves(stone, depth, ply, hashMove);
+
+    const Reversi::Stone    other { Reversi::otherColor(stone) };
+    const int               alphaOrig { alpha };
+    int                     bestScore { -m_Infinity };
+    int                     bestMove { TranspositionTable::m_NoMove };
+
+    for( int i { 0 }; i < static_cast<int>(moves.size()); ++i )
+    {
+        if( *m_Stop || cancelled() ) break;
+
+        selectMove(ply, i);                                                         // most promising one next
+
+        const FieldValue& move { moves[i] };
+
+        m_reversi.makeMove(move, stone);
+
+        int score { 0 };
+
+        if( 0 == i )
+            score = -negaMax(other, depth - 1, -beta, -alpha, ply + 1);
+        else
+        {
+            score = -negaMax(other, depth - 1, -alpha - 1, -alpha, ply + 1);        // prove it is not better
+            if( score > alpha && score < beta )
+                score = -negaMax(other, depth - 1, -beta, -alpha, ply + 1);         // it is, get the exact score
+        }
+
+        m_reversi.undoMove(move);
+
+        if( *m_Stop || cancelled() ) break;                                         // no valid score, no killer
+
+        if( score > bestScore )
+        {
+            bestScore = score;
+            bestMove  = packMove(move.getFieldPosition());
+        }
+
+        alpha = std::max(alpha, bestScore);
+
+        if( alpha >= beta )
+        {
+            storeCutoff(stone, depth, ply, bestMove);
+            break;
+        }
+
+        if( 0 == i && m_SplitScheduler && depth >= m_MinSplitDepth && moves.size() > 2 )
+        {
+            splitNode(stone, depth, alpha, beta, ply, bestScore, bestMove);         // the young brothers in parallel
+            break;
+        }
+    }
+
+    if( !*m_Stop && !cancelled() )                                                  // only complete results
+        m_TransTable->store(key, depth, bestScore, getBound(bestScore, alphaOrig, beta), bestMove);
+
+    return bestScore;
+}
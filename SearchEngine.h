@@ -0,0 +1,577 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef SEARCHENGINE_H
+#define SEARCHENGINE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Pos_Vect.h"
+#include "FieldList.h"
+#include "Reversi.h"
+#include "TranspositionTable.h"
+#include "ThreadPool.h"
+#include "WorkStealing.h"
+#include "PatternEvaluator.h"
+#include "OpeningBook.h"
+#include "PerfectPlayDB.h"
+
+// =====================================================================================================================
+
+/*! @brief computation of the next move, working on its own copy of the game
+ * @details The search engine takes a snapshot of a position and analyzes it without touching the game that is shown
+ * on the screen, so the display and the list of valid moves offered to the player stay untouched while a search is
+ * running - in another thread or several of them at the same time, one per engine.
+ *
+ * The search is a negamax alpha-beta search: every score is seen from the side to move, so a single function serves
+ * both players. It does a principal variation search - the first move of a position is searched with the full window,
+ * all others just with a null window to prove they are not better, only if that fails they are searched again. If a
+ * player can't move the turn passes to the opponent, the game is over when neither can move. Alternatively the root is
+ * driven by MTD(f), a series of null window searches converging to the score.
+ *
+ * With more than one thread, each of them works on its own copy of the game, in one of two modes:
+ * - root split: the first move of the root is searched alone, the others are handed out one by one to the workers of
+ *   a thread pool. The best score found so far is shared through an atomic, so every move is searched with the
+ *   tightest window known. Equal scores are decided by the order of the moves, so the result is the same as the one of
+ *   a single thread.
+ * - lazy SMP: all threads do their own iterative deepening of the whole tree, every other helper one ply deeper than
+ *   the main thread. They only communicate through the transposition table, where the helpers leave results the main
+ *   thread finds later on. The result is the one of the main thread, when it is done the helpers are stopped.
+ * - young brothers wait: the main thread searches the tree, once the first move of a node deep enough is searched,
+ *   the other moves become tasks on the work-stealing deque of the thread. Idle threads steal them, the thread that
+ *   split the node works on them as well and helps with the nodes split below it while waiting for the others. A
+ *   cut-off cancels all tasks of the node and of the nodes below it.
+ *
+ * The results of analyzed positions are kept in a transposition table, keyed by the Zobrist hash of the position and
+ * the side to move. So positions reached by different orders of moves are only analyzed once, and the table is kept
+ * from one computation to the next. The table is lock-free and shared by all threads.
+ *
+ * Positions at the depth limit are scored heuristically by the weights of the fields, the mobility and the parity,
+ * see EvalWeights - or on 8x8 boards by the weights of patterns of fields, if a file of weights is loaded, see
+ * PatternEvaluator. A finished game scores beyond any heuristic value, m_WinScore plus the disc difference.
+ *
+ * Near the end of the game, once the remaining depth reaches the last move, the position is solved exactly by the
+ * EndgameSolver working on the bit-board - with special ordering and no lists of moves, much faster than the generic
+ * search.
+ *
+ * If an opening book is loaded and holds the position, its move is played right away without any search. The same
+ * goes for the small boards, if a database of exact scores holds the positions after all moves.
+ *
+ * The earlier the best move of a position is searched, the more of the other moves are cut off. So the moves of each
+ * position are searched in this order: the best move stored in the transposition table, the killer moves of the ply
+ * (moves that caused a cut-off in a sibling position), then by the history heuristic (how often and how deep a move
+ * caused a cut-off anywhere in the tree) and finally by the number of moves left to the opponent.
+ *
+ * It contains:
+ * - the copy of the game to analyze
+ * - a move stack with one list of valid moves per ply, and the ordering keys of these moves
+ * - the killer moves per ply and the history table
+ * - the transposition table
+ * - a stop-flag to cancel a running computation
+ * - the helper engines and the thread pool of a parallel search
+ *
+ * It implements:
+ * - setting the position to analyze
+ * - setting the memory budget of the transposition table
+ * - selecting the search algorithm, the number of threads and how they share the work
+ * - compute the best next move via a negamax (alpha-beta) search, iteratively deepened until a depth limit is
+ *   reached or the time budget is used up
+ * - cancel the computation
+ */
+class SearchEngine
+{
+public:
+    /// @brief info to be returned by the next computed move
+    struct MoveInfo {
+        Pos_Vect pos;                                                               ///< position for stone
+        int      idx;                                                               ///< index of move in the list of
+                                                                                    ///      valid moves
+        int      score { 0 };                                                       ///< score of the move, beyond
+                                                                                    ///      +/- m_WinScore if the
+                                                                                    ///      game is decided
+        int      depth { 0 };                                                       ///< depth of the deepest
+                                                                                    ///      completed iteration
+        uint64_t nodes { 0 };                                                       ///< number of positions visited
+    };
+
+    /// @brief algorithm searching the root of each iteration
+    enum class Algorithm {
+        PVS,                                                                        ///< principal variation search
+        MTDf                                                                        ///< MTD(f), null window searches
+                                                                                    ///      around a guess
+    };
+
+    static constexpr const int      m_DefaultEndgameEmpties { 16 };     ///< solve positions with up to 16 empty fields
+    static constexpr const int      m_WinScore { 10000 };               ///< score of a won game, plus the disc
+                                                                        ///      difference
+
+    /// @brief how several threads share the work
+    enum class ParallelMode {
+        RootSplit,                                                                  ///< moves of the root are split
+                                                                                    ///      across the threads
+        LazySMP,                                                                    ///< all threads search the whole
+                                                                                    ///      tree, sharing the table
+        YBWC                                                                        ///< nodes are split once their
+                                                                                    ///      first move is searched
+    };
+
+    /*! @brief constructor
+     *
+     * @param position      game to analyze, a copy is taken
+     * @param hashSizeMB    memory budget of the transposition table in mega bytes
+     */
+    explicit SearchEngine( const Reversi& position,
+                           const size_t hashSizeMB = TranspositionTable::m_DefaultSizeMB );
+
+    /*! @brief set a new position to analyze
+     *
+     * @param position      game to analyze, must have the same board size, a copy is taken
+     */
+    void setPosition( const Reversi& position )
+    { m_reversi = position; }
+
+    /*! @brief set the memory budget of the transposition table, dropping its content
+     *
+     * @param sizeMB        size in mega bytes
+     */
+    void setHashSize( const size_t sizeMB )
+    { m_TransTable->resize(sizeMB); }
+
+    /*! @brief set when to switch to the exact endgame solver
+     *
+     * @param emptyFields   max. number of empty fields to solve a position, 0 to never use the solver
+     * @param winLossDraw   true to just find out if the game is won, lost or a draw when solving at the root -
+     *                      a lot faster than getting the exact score
+     */
+    void setEndgame( const int emptyFields, const bool winLossDraw = false )
+    {
+        m_EndgameEmpties     = emptyFields;
+        m_EndgameWinLossDraw = winLossDraw;
+    }
+
+    /*! @brief set the number of threads searching, from the next computation on
+     *
+     * @param numThreads    number of threads, at least 1 - each additional thread gets its own engine
+     */
+    void setThreads( const int numThreads );
+
+    /*! @brief select how several threads share the work
+     *
+     * @param mode          mode to use from the next computation on
+     */
+    void setParallelMode( const ParallelMode mode )
+    { m_ParallelMode = mode; }
+
+    /*! @brief get the number of threads searching
+     *
+     * @return              number of threads
+     */
+    int getThreads() const
+    { return static_cast<int>(m_Helpers.size()) + 1; }
+
+    /*! @brief select the search algorithm
+     *
+     * @param algorithm     algorithm to use from the next computation on
+     */
+    void setAlgorithm( const Algorithm algorithm )
+    { m_Algorithm = algorithm; }
+
+    /*! @brief load the weights of the pattern evaluation of 8x8 positions, see PatternEvaluator
+     *
+     * @param path          name of the file of weights
+     * @return              false if the file is missing or invalid - the weights of EvalWeights are used then
+     */
+    bool loadPatterns( const std::string& path );
+
+    /*! @brief load an opening book, consulted before each search, see OpeningBook
+     *
+     * @param path          name of the book
+     * @return              false if the file is missing or not a book for the size of the board
+     */
+    bool loadBook( const std::string& path );
+
+    /*! @brief load a database of exact scores of a small board, consulted before each search, see PerfectPlayDB
+     *
+     * @param path          name of the database
+     * @return              false if the file is missing or not a database for the size of the board
+     */
+    bool loadDatabase( const std::string& path );
+
+    /*! @brief set a function to call after each completed iteration of a computation, e.g. to report the progress
+     * @details It is called by the thread computing, with the best move so far - its node count is the one of that
+     * thread only.
+     *
+     * @param progress      function to call, an empty one to stop reporting
+     */
+    void setProgress( std::function<void( const MoveInfo& info )> progress )
+    { m_Progress = std::move(progress); }
+
+    /*! @brief compute a "good" next move by analysing all possibilities, does an alpha-beta search with iterative
+     * deepening: depth 1, 2, ... are searched until the max. depth is done or the time is up. The result is the best
+     * move of the deepest completed iteration.
+     *
+     * @param stone         stone to place
+     * @param depth         max. calculation depth - analyzing all moves up to that depth
+     * @param timeLimitMs   time budget in milli-seconds, 0 for no limit
+     * @return              move-info : position of stone and index of that move in the list of possible moves
+     */
+    MoveInfo computeNextMove( const Reversi::Stone stone, const int depth, const int timeLimitMs = 0 );
+
+    /*! @brief get the best move of the current position as far as the computations before found it, e.g. the reply
+     * they expect to the last computed move
+     *
+     * @param stone         stone to move
+     * @param pos           position of the move, if known
+     * @return              false if the transposition table has no move for the position
+     */
+    bool getHashMove( const Reversi::Stone stone, Pos_Vect& pos ) const;
+
+    /*! @brief cancel the calculation of the next move
+     *
+     */
+    void stop()
+    { m_stopCalculation = true; }
+
+protected:
+    using OrderKeys = std::array<int, FieldList::m_MaxFields>;          ///< ordering keys of the moves of a ply
+
+    /*! @brief get score of a finished game regarding a stone: any win is better than any heuristic score
+     *
+     * @param stone     stone to check
+     * @return          m_WinScore plus the disc difference if won, minus m_WinScore plus the difference if lost
+     */
+    int      getFinalScore( const Reversi::Stone stone ) const
+    { return toFinalScore(Reversi::Stone::WhiteStone == stone
+                          ? m_reversi.getWhiteNum() - m_reversi.getBlackNum()
+                          : m_reversi.getBlackNum() - m_reversi.getWhiteNum()); }
+
+    /*! @brief heuristic score of the position regarding a stone, see EvalWeights
+     *
+     * @param stone     stone to move
+     * @return          score
+     */
+    int      evaluate( const Reversi::Stone stone ) const;
+
+    /*! @brief map the disc difference of a finished game to its score
+     *
+     * @param discs     disc difference
+     * @return          score
+     */
+    static constexpr int toFinalScore( const int discs )
+    { return discs > 0 ? m_WinScore + discs : discs < 0 ? -m_WinScore + discs : 0; }
+
+    /*! @brief map a bound of a search window to disc differences: the highest disc difference whose score does not
+     * exceed the bound
+     *
+     * @param bound     bound of a window
+     * @return          disc difference
+     */
+    static constexpr int toDiscBound( const int bound )
+    {
+        return bound > m_WinScore   ? bound - m_WinScore
+             : bound >= 0           ? 0
+             : bound >= -m_WinScore ? -1
+             :                        bound + m_WinScore;
+    }
+
+    /*! @brief iterative deepening: search the root with increasing depth until the max. depth is done or the search
+     * is stopped
+     *
+     * @param stone         stone to move
+     * @param maxDepth      max. depth to analyze
+     * @param firstDepth    depth of the first iteration
+     * @param ret           result of the deepest completed iteration, kept if none completes
+     */
+    void     deepen( const Reversi::Stone stone, const int maxDepth, const int firstDepth, MoveInfo& ret );
+
+    /*! @brief search the moves of the root with a principal variation search
+     *
+     * @param stone     stone to move
+     * @param depth     depth to analyze
+     * @param alpha     lower bound of the window
+     * @param beta      upper bound of the window
+     * @param bestIdx   index of the best move in the list of valid moves, unchanged if no move was completed
+     * @return          score of the best move, from the view of stone
+     */
+    int      searchRoot( const Reversi::Stone stone, const int depth, const int alpha, const int beta, int& bestIdx );
+
+    /*! @brief search the moves of the root with all threads: the first move alone, then the others in parallel
+     *
+     * @param stone     stone to move
+     * @param depth     depth to analyze
+     * @param bestIdx   index of the best move in the list of valid moves, unchanged if no move was completed
+     * @return          score of the best move, from the view of stone
+     */
+    int      searchRootParallel( const Reversi::Stone stone, const int depth, int& bestIdx );
+
+    /*! @brief worker of the parallel root search: take the next move to search until all are taken
+     * @details A move before the best one in the order of the root has to reach the best score, a move after it has
+     * to exceed it - so the move is searched with a null window at that bound first.
+     *
+     * @param stone     stone to move
+     * @param depth     depth to analyze
+     * @param order     order of the root moves
+     * @param next      position in the order of the next move to take, shared by all workers
+     * @param best      best score and its position in the order so far, packed, shared by all workers
+     */
+    void     searchRootMoves( const Reversi::Stone stone, const int depth, const OrderKeys& order,
+                              std::atomic<int>& next, std::atomic<int64_t>& best );
+
+    /*! @brief search the moves of a node after the first one in parallel: they become tasks on the queue of this
+     * thread, it searches them itself unless they are stolen and helps with the nodes split below the node until all
+     * tasks are done
+     *
+     * @param stone     stone to move
+     * @param depth     remaining depth of the node
+     * @param alpha     lower bound of the window, including the score of the first move
+     * @param beta      upper bound of the window
+     * @param ply       distance to the root of the search, selects the list on the move stack
+     * @param bestScore best score of the node, the one of the first move on entry
+     * @param bestMove  best move of the node, packed, the first move on entry
+     */
+    void     splitNode( const Reversi::Stone stone, const int depth, const int alpha, const int beta, const int ply,
+                        int& bestScore, int& bestMove );
+
+    /*! @brief search a move of a split node and report the result to it, at the ply of the move from the root
+     *
+     * @param task      task: split node and move
+     */
+    void     runTask( const SplitTask& task );
+
+    /*! @brief take a task from the queue of another thread
+     *
+     * @param task      task taken
+     * @param subtree   only take a task of this split node or one below it, nullptr to take any
+     * @return          true if a task was taken
+     */
+    bool     stealTask( SplitTask& task, const SplitPoint* subtree );
+
+    /*! @brief main loop of a helper thread splitting nodes: steal and search tasks until the main thread is done
+     *
+     */
+    void     helpSearch();
+
+    /*! @brief check if the result of the current task is not needed any more
+     *
+     * @return          true if a split node the task belongs to got a cut-off
+     */
+    bool     cancelled() const
+    { return m_ActiveSplit && m_ActiveSplit->cancelled(); }
+
+    /*! @brief find the score of the root by MTD(f): null window searches, each one moving the bound towards the score
+     *
+     * @param stone     stone to move
+     * @param depth     depth to analyze
+     * @param guess     first guess of the score, e.g. the score of the previous iteration
+     * @param bestIdx   index of the best move in the list of valid moves
+     * @return          score of the best move, from the view of stone
+     */
+    int      searchMTDf( const Reversi::Stone stone, const int depth, const int guess, int& bestIdx );
+
+    /*! @brief negamax search with principal variation search
+     *
+     * @param stone     stone to move
+     * @param depth     remaining depth to analyze
+     * @param alpha     lower bound of the window, from the view of stone
+     * @param beta      upper bound of the window, from the view of stone
+     * @param ply       distance to the root of the search, selects the list on the move stack
+     * @param passed    true if the opponent just passed
+     * @return          score of the position from the view of stone - fail-soft, so it may be outside the window
+     */
+    int      negaMax( const Reversi::Stone stone, const int depth, int alpha, const int beta, const int ply,
+                      const bool passed = false );
+
+    /*! @brief look up the positions after all moves of the root in the database of exact scores, the list of moves
+     * of the root must be filled
+     *
+     * @param stone     stone to move
+     * @param info      the best move and its score, if all positions are known
+     * @return          true if all positions are known
+     */
+    bool     probeDatabase( const Reversi::Stone stone, MoveInfo& info );
+
+    /*! @brief solve the current position exactly by the endgame solver
+     *
+     * @param stone     stone to move
+     * @param alpha     lower bound of the window
+     * @param beta      upper bound of the window
+     * @return          final disc difference from the view of stone, fail-soft
+     */
+    int      solveEndgame( const Reversi::Stone stone, const int alpha, const int beta );
+
+    /*! @brief count a visited position, from time to time check if the time is up and stop if so - and publish the
+     * count to the other threads
+     *
+     */
+    void     checkTime();
+
+    /*! @brief get the number of positions visited by this engine and its helpers so far
+     * @details The helpers may still be searching, their counts are the ones published by their last time check.
+     *
+     * @return          number of positions
+     */
+    uint64_t countNodes() const;
+
+    /*! @brief get the key of the current position for the transposition table
+     *
+     * @param stone     stone to move
+     * @return          key
+     */
+    uint64_t getHashKey( const Reversi::Stone stone ) const;
+
+    /*! @brief look up the current position, check if the stored result can be used for the current window
+     *
+     * @param key       key of the position
+     * @param depth     remaining depth, the stored analysis must be at least that deep
+     * @param alpha     lower bound of the window
+     * @param beta      upper bound of the window
+     * @param score     stored score, if usable
+     * @param hashMove  stored best move, packed, or TranspositionTable::m_NoMove
+     * @return          true if the stored score can be returned right away
+     */
+    bool     probeTable( const uint64_t key, const int depth, const int alpha, const int beta, int& score,
+                         int& hashMove ) const;
+
+    /*! @brief compute the ordering keys of the valid moves of a ply
+     *
+     * @param stone     stone to move
+     * @param depth     remaining depth, the opponent's mobility is only checked if deep enough to pay off
+     * @param ply       distance to the root of the search, selects the list on the move stack
+     * @param hashMove  best move stored in the transposition table, packed, or TranspositionTable::m_NoMove
+     */
+    void     orderMoves( const Reversi::Stone stone, const int depth, const int ply, const int hashMove );
+
+    /*! @brief move the most promising of the remaining moves of a ply to a position of the list
+     * @details selection instead of sorting, most positions are cut off after the first few moves
+     *
+     * @param ply       distance to the root of the search, selects the list on the move stack
+     * @param first     position of the list to fill, all moves before it have been searched
+     */
+    void     selectMove( const int ply, const int first );
+
+    /*! @brief remember a move that caused a cut-off as killer move of the ply and in the history table
+     *
+     * @param stone     stone that made the move
+     * @param depth     remaining depth of the position
+     * @param ply       distance to the root of the search
+     * @param move      packed move
+     */
+    void     storeCutoff( const Reversi::Stone stone, const int depth, const int ply, const int move );
+
+    /*! @brief prepare a computation: reset the node count, killer moves, age the history and the table
+     *
+     * @param deadline  end of the time budget
+     */
+    void     startSearch( const std::chrono::steady_clock::time_point deadline );
+
+    /*! @brief pack a score of the root and the position of its move in the order, higher values are better
+     *
+     * @param score     score
+     * @param pos       position of the move in the order of the root, the lower the better for equal scores
+     * @return          packed score
+     */
+    static int64_t packRootScore( const int score, const int pos )
+    { return ( static_cast<int64_t>(score + m_Infinity) << 8 ) | ( 0xff - pos ); }
+
+    /*! @brief get the score of a packed root score
+     *
+     * @param packed    packed score
+     * @return          score
+     */
+    static int unpackRootScore( const int64_t packed )
+    { return static_cast<int>(packed >> 8) - m_Infinity; }
+
+    /*! @brief get the position in the order of the root of a packed root score
+     *
+     * @param packed    packed score
+     * @return          position of the move in the order of the root
+     */
+    static int unpackRootPos( const int64_t packed )
+    { return 0xff - static_cast<int>(packed & 0xff); }
+
+    /*! @brief pack a position for the transposition table
+     *
+     * @param pos       position
+     * @return          packed move
+     */
+    static int packMove( const Pos_Vect& pos );
+
+    /*! @brief get the type of bound a score represents regarding the search window
+     *
+     * @param score     score found
+     * @param alpha     lower bound of the window when the search started
+     * @param beta      upper bound of the window when the search started
+     * @return          bound
+     */
+    static TranspositionTable::Bound getBound( const int score, const int alpha, const int beta );
+
+private:
+    /*! @brief constructor of a helper engine of a parallel search
+     *
+     * @param position      game to analyze, a copy is taken
+     * @param transTable    transposition table shared with the main engine
+     * @param stop          stop-flag of the main engine
+     */
+    SearchEngine( const Reversi& position, const std::shared_ptr<TranspositionTable>& transTable,
+                  std::atomic<bool>& stop );
+
+    static constexpr const int      m_MaxPly { 64 };                    ///< max. search depth / size of move stack
+    static constexpr const int      m_Infinity { 1 << 20 };             ///< above any score
+    static constexpr const uint64_t m_TimeCheckMask { 1023 };          ///< check the time every 1024 positions
+    static constexpr const int      m_NumKillers { 2 };                 ///< killer moves per ply
+    static constexpr const int      m_HashMoveKey { 1 << 30 };          ///< ordering key of the hash move
+    static constexpr const int      m_KillerKey { 1 << 29 };            ///< ordering key of the first killer move
+    static constexpr const int      m_MobilityDepth { 3 };              ///< min. depth to order by mobility
+    static constexpr const int      m_MinSplitDepth { 4 };              ///< min. depth to split a node
+    static constexpr const int      m_EndgamePrepDepth { 4 };           ///< iterations before solving the root
+
+    using Killers   = std::array<int, m_NumKillers>;                    ///< killer moves of a ply, packed
+    using History   = std::array<std::array<int, 256>, 2>;              ///< cut-off counts per color and packed move
+
+    Reversi                 m_reversi;                                  ///< own copy of the game
+    std::vector<FieldList>  m_MoveStack;                                ///< valid moves per ply of the search
+    OrderKeys               m_RootOrder {};                             ///< order to search the moves of the root
+    std::vector<OrderKeys>  m_OrderKeys;                                ///< ordering keys per ply of the search
+    std::vector<Killers>    m_Killers;                                  ///< killer moves per ply of the search
+    History                 m_History {};                               ///< history heuristic
+    std::shared_ptr<const PatternEvaluator> m_Patterns;                 ///< pattern weights if loaded, shared by
+                                                                        ///      all threads
+    std::unique_ptr<OpeningBook>        m_Book;                         ///< opening book if loaded
+    std::unique_ptr<PerfectPlayDB>      m_Database;                     ///< exact scores of a small board if loaded
+    std::shared_ptr<TranspositionTable> m_TransTable;                   ///< already analyzed positions, shared by
+                                                                        ///      all threads
+
+    Algorithm               m_Algorithm { Algorithm::PVS };             ///< algorithm searching the root
+    ParallelMode            m_ParallelMode { ParallelMode::RootSplit }; ///< sharing the work of the threads
+    int                     m_EndgameEmpties { m_DefaultEndgameEmpties };   ///< max. empty fields to solve
+    bool                    m_EndgameWinLossDraw { false };             ///< solve the root for win/loss/draw only
+    uint64_t                m_NodeCount { 0 };                          ///< positions visited by the search
+    std::atomic<uint64_t>   m_PublishedNodes { 0 };                     ///< m_NodeCount as of the last time check,
+                                                                        ///      read by the main thread
+    std::function<void( const MoveInfo& info )> m_Progress;             ///< called after each iteration, if set
+    std::chrono::steady_clock::time_point m_Deadline {};                ///< end of the time budget
+
+    std::atomic<bool>       m_stopCalculation { false };                ///< stop-flag
+    std::atomic<bool>*      m_Stop { &m_stopCalculation };              ///< stop-flag to check, the one of the
+                                                                        ///      main engine for a helper
+
+    std::vector<std::unique_ptr<SearchEngine>> m_Helpers;               ///< engines of the other threads
+    std::unique_ptr<ThreadPool> m_Pool;                                 ///< threads of a parallel search
+    std::unique_ptr<SplitScheduler> m_Scheduler;                        ///< task queues of all threads
+
+    SplitScheduler*         m_SplitScheduler { nullptr };               ///< queues of a search splitting nodes,
+                                                                        ///      nullptr if nodes are not split
+    int                     m_WorkerId { 0 };                           ///< number of the thread, its queue
+    const SplitPoint*       m_ActiveSplit { nullptr };                  ///< split node of the current task
+};
+
+#endif //SEARCHENGINE_H
@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "SearchEngine.h"
+#include "TestPositions.h"
+
+// =====================================================================================================================
+
+// compare the parallel searches on the fixed test positions: every position is searched to a fixed depth by a fresh
+// engine (empty transposition table) per mode - usage: smp_bench [threads [depth]]
+
+int main( int argc, char* argv[] )
+{
+    const int hwThreads { static_cast<int>(std::thread::hardware_concurrency()) };
+    const int numThreads { argc > 1 ? std::atoi(argv[1]) : std::max(hwThreads, 1) };
+    const int depth { argc > 2 ? std::atoi(argv[2]) : 10 };
+
+    struct Mode
+    {
+        const char*                 name;
+        SearchEngine::ParallelMode  mode;
+    };
+
+    static const Mode modes[] { { "lazy-smp", SearchEngine::ParallelMode::LazySMP },
+                                { "ybwc",     SearchEngine::ParallelMode::YBWC } };
+
+    std::printf("threads %d, depth %d\n", numThreads, depth);
+    std::printf("%-14s %-10s %6s %10s %14s %12s %6s\n", "position", "mode", "depth", "time [ms]", "nodes",
+                "nodes/s", "score");
+
+    for( const auto& mode : modes )
+    {
+        double      totalMs { 0.0 };
+        uint64_t    totalNodes { 0 };
+
+        for( const auto& position : TestPositions::positions )
+        {
+            const Reversi   reversi { TestPositions::setup(position) };
+            SearchEngine    engine { reversi };
+
+            engine.setThreads(numThreads);
+            engine.setParallelMode(mode.mode);
+
+            const auto                      start { std::chrono::steady_clock::now() };
+            const SearchEngine::MoveInfo    info { engine.computeNextMove(position.toMove, depth) };
+            const double                    ms { std::chrono::duration<double, std::milli>(
+                                                     std::chrono::steady_clock::now() - start).count() };
+
+            totalMs    += ms;
+            totalNodes += info.nodes;
+
+            std::printf("%-14s %-10s %6d %10.1f %14llu %12.0f %6d\n", position.name, mode.name, info.depth, ms,
+                        static_cast<unsigned long long>(info.nodes), info.nodes / std::max(ms, 1e-3) * 1000.0,
+                        info.score);
+        }
+
+        std::printf("%-14s %-10s %6s %10.1f %14llu %12.0f\n", "total", mode.name, "", totalMs,
+                    static_cast<unsigned long long>(totalNodes), totalNodes / std::max(totalMs, 1e-3) * 1000.0);
+    }
+
+    return 0;
+}
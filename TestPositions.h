@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef TESTPOSITIONS_H
+#define TESTPOSITIONS_H
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "Reversi.h"
+
+// =====================================================================================================================
+
+/*! @brief fixed positions to compare searches and measure their speed
+ * @details Positions of the opening and the middle game for several board sizes, reached by random moves. A position
+ * is given row by row, 'X' marks a black stone, 'O' a white one, '-' an empty field.
+ *
+ * The tools making positions of their own use the random moves here: from a fixed seed they give the same positions
+ * on every platform, as the moves are picked by the modulo of the numbers of the generator - the distributions of the
+ * standard library differ between the implementations.
+ */
+namespace TestPositions
+{
+    /// @brief a position and the side to move
+    struct Position
+    {
+        const char*     name;                                           ///< name to report
+        int             size;                                           ///< number of rows and coloumns
+        Reversi::Stone  toMove;                                         ///< stone to move
+        const char*     board;                                          ///< fields, row by row
+    };
+
+    constexpr const uint32_t randomSeed { 20170901 };                   ///< seed of the random moves of the tools
+
+    static const std::array<Position, 7> positions { {
+        { "6x6-opening", 6, Reversi::Stone::BlackStone,
+          "---XXX"
+          "-OOXX-"
+          "--OOOX"
+          "--OOO-"
+          "------"
+          "------" },
+        { "8x8-opening", 8, Reversi::Stone::BlackStone,
+          "--------"
+          "--XO----"
+          "---O-X--"
+          "--OXXXO-"
+          "-OOXXX--"
+          "-O---X--"
+          "--------"
+          "--------" },
+        { "8x8-early", 8, Reversi::Stone::BlackStone,
+          "--O-----"
+          "---O-X--"
+          "-X-XOOO-"
+          "-OXOXX--"
+          "OOOXX---"
+          "X-X-XX--"
+          "-X----X-"
+          "--------" },
+        { "8x8-middle-1", 8, Reversi::Stone::BlackStone,
+          "--------"
+          "-----O--"
+          "----OOOO"
+          "--OOOO--"
+          "--XOXXX-"
+          "---XOXX-"
+          "-OOOO-XX"
+          "-X-XO--X" },
+        { "8x8-middle-2", 8, Reversi::Stone::BlackStone,
+          "----X---"
+          "----OX--"
+          "----OOXX"
+          "OOOOOOX-"
+          "OOOOXXXO"
+          "O-OXXX-X"
+          "-O-XX-O-"
+          "O--X----" },
+        { "8x8-middle-3", 8, Reversi::Stone::BlackStone,
+          "----OX--"
+          "--XOOX--"
+          "---OOOX-"
+          "XXXOXOXX"
+          "XXOOOX-X"
+          "XXXOXXX-"
+          "X-OXX---"
+          "-OOOX---" },
+        { "10x10-early", 10, Reversi::Stone::BlackStone,
+          "----------"
+          "----------"
+          "----------"
+          "-----OOO--"
+          "----OXOO--"
+          "---OXOXO--"
+          "----XOXXO-"
+          "----XXX--O"
+          "----X-XO--"
+          "----------" }
+    } };
+
+    /*! @brief set up the board of a position
+     *
+     * @param position  position to set up
+     * @return          game in that position
+     */
+    inline Reversi setup( const Position& position )
+    {
+        Reversi reversi { position.size };
+
+        for( int y { 0 }; y < position.size; ++y )
+        {
+            for( int x { 0 }; x < position.size; ++x )
+            {
+                const char field { position.board[y * position.size + x] };
+
+                reversi.removeStone({ x, y });
+
+                if( 'X' == field )      reversi.setStone({ x, y }, Reversi::Stone::BlackStone);
+                else if( 'O' == field ) reversi.setStone({ x, y }, Reversi::Stone::WhiteStone);
+            }
+        }
+        return reversi;
+    }
+
+    /*! @brief get the moves of the side to move - if it has none, the other side passes to it
+     *
+     * @param reversi   game
+     * @param toMove    stone to move, changes if it has to pass
+     * @return          moves, empty if the game is over
+     */
+    inline FieldList getMovesOrPass( Reversi& reversi, Reversi::Stone& toMove )
+    {
+        FieldList moves { reversi.getValidMoves(toMove) };
+
+        if( 0 == moves.size() )
+        {
+            toMove = Reversi::otherColor(toMove);
+            moves  = reversi.getValidMoves(toMove);
+        }
+        return moves;
+    }
+
+    /*! @brief pick a random move
+     *
+     * @param moves     moves to pick from, not empty
+     * @param random    generator
+     * @return          index of the move
+     */
+    inline int randomIndex( const FieldList& moves, std::mt19937& random )
+    { return static_cast<int>(random() % moves.size()); }                // modulo is the same everywhere
+
+    /*! @brief make a random move, passing if the side to move has none
+     *
+     * @param reversi   game
+     * @param toMove    stone to move, gets the one to move next
+     * @param random    generator
+     * @return          false if the game is over, no move is made then
+     */
+    inline bool makeRandomMove( Reversi& reversi, Reversi::Stone& toMove, std::mt19937& random )
+    {
+        const FieldList moves { getMovesOrPass(reversi, toMove) };
+
+        if( 0 == moves.size() )
+            return false;
+
+        reversi.makeMove(moves[randomIndex(moves, random)], toMove);
+        toMove = Reversi::otherColor(toMove);
+        return true;
+    }
+}
+
+#endif //TESTPOSITIONS_H
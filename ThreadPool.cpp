@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+// =====================================================================================================================
+
+ThreadPool::ThreadPool( const int numWorkers )
+{
+    const int numThreads { std::max(numWorkers, 1) - 1 };                           // the caller is a worker as well
+
+    m_Threads.reserve(numThreads);
+
+    for( int worker { 1 }; worker <= numThreads; ++worker )
+        m_Threads.emplace_back(&ThreadPool::work, this, worker);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock { m_Mutex };
+        m_Quit = true;
+    }
+    m_JobReady.notify_all();
+
+    for( auto& thread : m_Threads )
+        thread.join();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ThreadPool::run( const Job& job )
+{
+    {
+        std::lock_guard<std::mutex> lock { m_Mutex };
+        m_Job     = &job;
+        m_Running = static_cast<int>(m_Threads.size());
+        ++m_Generation;
+    }
+    m_JobReady.notify_all();
+
+    job(0);                                                                         // do our part
+
+    std::unique_lock<std::mutex> lock { m_Mutex };                                  // wait for the others
+    m_JobDone.wait(lock, [this]() { return 0 == m_Running; });
+    m_Job = nullptr;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ThreadPool::work( const int worker )
+{
+    uint64_t generation { 0 };
+
+    for( ;; )
+    {
+        const Job* job { nullptr };
+
+        {
+            std::unique_lock<std::mutex> lock { m_Mutex };
+            m_JobReady.wait(lock, [this, generation]() { return m_Quit || m_Generation != generation; });
+
+            if( m_Quit )
+                return;
+
+            generation = m_Generation;
+            job        = m_Job;
+        }
+
+        ( *job )(worker);
+
+        {
+            std::lock_guard<std::mutex> lock { m_Mutex };
+            --m_Running;
+        }
+        m_JobDone.notify_one();
+    }
+}
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =====================================================================================================================
+
+/*! @brief fixed set of worker threads running one job at a time, all of them on the same job
+ * @details The threads are started once and wait for a job, so a search doesn't pay for starting threads on every
+ * iteration. A job is a function getting the number of the worker running it. The calling thread takes part as worker
+ * 0, the pool threads are worker 1 .. size() - 1. run() returns when all workers are done with the job.
+ *
+ * It contains
+ * - the worker threads
+ * - the job to run and the state to hand it over
+ *
+ * It implements
+ * - running a job on all workers and waiting for them to finish
+ */
+class ThreadPool
+{
+public:
+    using Job = std::function<void( const int worker )>;                    ///< job, gets the number of the worker
+
+    /*! @brief constructor, starts the threads
+     *
+     * @param numWorkers    number of workers including the calling thread, at least 1
+     */
+    explicit ThreadPool( const int numWorkers );
+
+    /*! @brief destructor, stops the threads
+     *
+     */
+    ~ThreadPool();
+
+    ThreadPool( const ThreadPool& ) = delete;
+    ThreadPool& operator=( const ThreadPool& ) = delete;
+
+    /*! @brief get the number of workers
+     *
+     * @return          number of workers including the calling thread
+     */
+    int size() const
+    { return static_cast<int>(m_Threads.size()) + 1; }
+
+    /*! @brief run a job on all workers, the calling thread is worker 0 - wait for all of them to finish
+     *
+     * @param job       job to run
+     */
+    void run( const Job& job );
+
+protected:
+    /*! @brief main loop of a pool thread: wait for a job, run it, report when done
+     *
+     * @param worker    number of the worker
+     */
+    void work( const int worker );
+
+private:
+    std::vector<std::thread>    m_Threads;                                  ///< pool threads
+    std::mutex                  m_Mutex;                                    ///< guards the state below
+    std::condition_variable     m_JobReady;                                 ///< signals a new job or the end
+    std::condition_variable     m_JobDone;                                  ///< signals a worker being done
+    const Job*                  m_Job { nullptr };                          ///< job to run
+    uint64_t                    m_Generation { 0 };                         ///< counts the jobs handed out
+    int                         m_Running { 0 };                            ///< pool threads still busy with the job
+    bool                        m_Quit { false };                           ///< stop the threads
+};
+
+#endif //THREADPOOL_H
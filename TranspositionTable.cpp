@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#include <algorithm>
+
+#include "TranspositionTable.h"
+
+// =====================================================================================================================
+
+TranspositionTable::TranspositionTable( const size_t sizeMB )
+{
+    resize(sizeMB);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TranspositionTable::resize( const size_t sizeMB )
+{
+    const size_t bytes { sizeMB * 1024 * 1024 };
+    size_t       buckets { 1 };
+
+    while( buckets * 2 * sizeof(Bucket) <= bytes )                          // largest power of 2 within the budget
+        buckets *= 2;
+
+    m_Buckets.reset(new Bucket[buckets]);
+    m_Mask = buckets - 1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TranspositionTable::clear()
+{
+    for( size_t i { 0 }; i <= m_Mask; ++i )
+        for( auto& slot : m_Buckets[i].m_Slots )
+        {
+            slot.m_Key.store(0, std::memory_order_relaxed);
+            slot.m_Data.store(0, std::memory_order_relaxed);
+        }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool TranspositionTable::probe( const uint64_t key, Entry& entry ) const
+{
+    const Bucket& bucket { m_Buckets[key & m_Mask] };
+
+    for( const auto& slot : bucket.m_Slots )
+    {
+        const uint64_t data { slot.m_Data.load(std::memory_order_relaxed) };
+
+        if( data && ( slot.m_Key.load(std::memory_order_relaxed) ^ data ) == key )    // torn entries don't match
+        {
+            entry = unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void TranspositionTable::store( const uint64_t key, const int depth, const int score, const Bound bound,
+                                const int move )
+{
+    Bucket&     bucket { m_Buckets[key & m_Mask] };
+    Slot*       replace { &bucket.m_Slots[0] };
+    uint64_t    replaceData { replace->m_Data.load(std::memory_order_relaxed) };
+    bool        samePosition { false };
+    int         replaceValue { 1 << 30 };
+
+    for( auto& slot : bucket.m_Slots )
+    {
+        const uint64_t data { slot.m_Data.load(std::memory_order_relaxed) };
+
+        samePosition = data && ( slot.m_Key.load(std::memory_order_relaxed) ^ data ) == key;
+
+        if( samePosition || !data )                                         // same position or empty: take it
+        {
+            replace     = &slot;
+            replaceData = data;
+            break;
+        }
+
+        // prefer to replace shallow entries, entries of older searches count as even more shallow
+        const Entry     stored { unpack(data) };
+        const int       value { stored.depth - 4 * static_cast<uint8_t>(m_Age - ageOf(data)) };
+
+        if( value < replaceValue )
+        {
+            replace      = &slot;
+            replaceData  = data;
+            replaceValue = value;
+        }
+    }
+
+    int keepMove { move };
+
+    if( samePosition )
+    {
+        const Entry stored { unpack(replaceData) };
+
+        // a deeper exact result of the same position is kept, unless this one is exact as well
+        if( stored.depth > depth && Bound::Exact == stored.bound && Bound::Exact != bound )
+            return;
+
+        if( m_NoMove == keepMove )                                          // keep the best move if none is known
+            keepMove = stored.move;
+    }
+
+    const uint64_t data { pack(depth, score, bound, keepMove, m_Age) };
+
+    replace->m_Key.store(key ^ data, std::memory_order_relaxed);
+    replace->m_Data.store(data, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// layout: score (16 bit) | depth (8 bit) | bound (8 bit) | move (8 bit) | age (8 bit), bound != None marks it used
+
+uint64_t TranspositionTable::pack( const int depth, const int score, const Bound bound, const int move,
+                                   const uint8_t age )
+{
+    return   static_cast<uint64_t>(static_cast<uint16_t>(score))
+           | static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 16
+           | static_cast<uint64_t>(bound) << 24
+           | static_cast<uint64_t>(static_cast<uint8_t>(move)) << 32
+           | static_cast<uint64_t>(age) << 40;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+TranspositionTable::Entry TranspositionTable::unpack( const uint64_t data )
+{
+    Entry entry {};
+
+    entry.score = static_cast<int16_t>(data & 0xffff);
+    entry.depth = static_cast<int>(( data >> 16 ) & 0xff);
+    entry.bound = static_cast<Bound>(( data >> 24 ) & 0xff);
+    entry.move  = static_cast<int>(( data >> 32 ) & 0xff);
+
+    return entry;
+}
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+// =====================================================================================================================
+
+/*! @brief memory of already analyzed positions, to be reused when a position is reached by another order of moves
+ * @details The table is an array of buckets, indexed by the lower bits of the Zobrist hash of a position. Each bucket
+ * is exactly one cache-line (64 bytes) and holds four entries, so a lookup costs a single memory access. An entry
+ * stores the full hash, to detect collisions, and in one packed 64-bit word: score, depth of the analysis, the type
+ * of bound the score represents and the best move found.
+ *
+ * When a bucket is full, the entry with the lowest depth - preferring entries of older searches - is replaced.
+ *
+ * The table may be shared by several threads searching at the same time, without any lock: both words of an entry are
+ * atomics, read and written independently, and the key is stored xor-ed with the data. If another thread overwrote
+ * one of the words in between, the key doesn't match any more and the entry is just not found - a torn entry is never
+ * used.
+ *
+ * It contains
+ * - the buckets
+ * - the current "age", incremented for each new search
+ *
+ * It implements
+ * - setting the memory budget
+ * - looking up a position
+ * - storing the result of an analysis
+ */
+class TranspositionTable
+{
+public:
+    static constexpr const size_t   m_DefaultSizeMB { 16 };                 ///< default memory budget
+    static constexpr const int      m_NoMove { 0xff };                      ///< no best move known
+
+    /// meaning of a stored score
+    enum class Bound : uint8_t
+    {
+        None,                                                               ///< unused entry
+        Exact,                                                              ///< exact score
+        Lower,                                                              ///< score is at least this
+        Upper                                                               ///< score is at most this
+    };
+
+    /// result of a lookup
+    struct Entry
+    {
+        int     score { 0 };                                                ///< score
+        int     depth { 0 };                                                ///< depth of the analysis
+        Bound   bound { Bound::None };                                      ///< type of score
+        int     move { m_NoMove };                                          ///< best move, packed (x << 4 | y)
+    };
+
+    /*! @brief constructor
+     *
+     * @param sizeMB    memory budget in mega bytes
+     */
+    explicit TranspositionTable( const size_t sizeMB = m_DefaultSizeMB );
+
+    /*! @brief set the memory budget, dropping all entries
+     *
+     * @param sizeMB    memory budget in mega bytes, the table uses the largest power of 2 buckets that fits
+     */
+    void resize( const size_t sizeMB );
+
+    /*! @brief drop all entries
+     *
+     */
+    void clear();
+
+    /*! @brief start a new search, entries of previous ones will be replaced first - must not be called while other
+     * threads use the table
+     *
+     */
+    void newSearch()
+    { ++m_Age; }
+
+    /*! @brief look up a position
+     *
+     * @param key       hash of the position
+     * @param entry     found entry
+     * @return          true if the position was found
+     */
+    bool probe( const uint64_t key, Entry& entry ) const;
+
+    /*! @brief store the result of an analysis
+     *
+     * @param key       hash of the position
+     * @param depth     depth of the analysis
+     * @param score     score
+     * @param bound     type of score
+     * @param move      best move, packed (x << 4 | y), or m_NoMove
+     */
+    void store( const uint64_t key, const int depth, const int score, const Bound bound, const int move );
+
+    /*! @brief number of buckets
+     *
+     * @return          size of the table
+     */
+    size_t size() const
+    { return m_Mask + 1; }
+
+private:
+    static constexpr const int  m_SlotsPerBucket { 4 };                     ///< entries per cache-line
+
+    /// a single entry as stored in the table
+    struct Slot
+    {
+        std::atomic<uint64_t>   m_Key { 0 };                                ///< full hash of the position ^ m_Data
+        std::atomic<uint64_t>   m_Data { 0 };                               ///< packed entry
+    };
+
+    /// one cache-line of entries
+    struct alignas(64) Bucket
+    {
+        std::array<Slot, m_SlotsPerBucket>  m_Slots {};                     ///< entries
+    };
+
+    static_assert( sizeof(Bucket) == 64, "bucket must fill one cache-line" );
+
+    /*! @brief pack an entry into one word
+     *
+     * @param depth     depth
+     * @param score     score
+     * @param bound     bound
+     * @param move      move
+     * @param age       age of the search
+     * @return          packed entry
+     */
+    static uint64_t pack( const int depth, const int score, const Bound bound, const int move, const uint8_t age );
+
+    /*! @brief unpack an entry
+     *
+     * @param data      packed entry
+     * @return          entry
+     */
+    static Entry unpack( const uint64_t data );
+
+    /*! @brief get age of a packed entry
+     *
+     * @param data      packed entry
+     * @return          age
+     */
+    static uint8_t ageOf( const uint64_t data )
+    { return static_cast<uint8_t>(data >> 40); }
+
+    std::unique_ptr<Bucket[]>   m_Buckets;                                  ///< the table
+    size_t                      m_Mask { 0 };                               ///< number of buckets - 1
+    uint8_t                     m_Age { 0 };                                ///< age of the current search
+};
+
+#endif //TRANSPOSITIONTABLE_H
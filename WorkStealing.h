@@ -0,0 +1,211 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef WORKSTEALING_H
+#define WORKSTEALING_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "FieldList.h"
+#include "Reversi.h"
+
+// =====================================================================================================================
+
+/*! @brief node of the search tree whose remaining moves are searched by several threads ("young brothers wait")
+ * @details Once the first move of a node is searched, the other moves are handed out as tasks. The split point keeps
+ * everything a thread needs to search one of these moves: the position, the moves, the window - and collects the
+ * results. If a move causes a cut-off, the split point is cancelled and so are all split points below it, the
+ * threads still searching one of their moves stop as soon as they notice.
+ *
+ * The split point lives on the stack of the thread that created it, it waits for all tasks to be done before
+ * returning, so the split point outlives all of them - as well as all split points below it.
+ */
+struct SplitPoint
+{
+    /*! @brief constructor
+     *
+     * @param position      position of the node
+     * @param stone         stone to move
+     * @param depth         remaining depth of the node
+     * @param ply           distance of the node to the root of the search
+     * @param alpha         lower bound of the window
+     * @param beta          upper bound of the window
+     * @param bestScore     best score so far, the one of the first move
+     * @param bestMove      best move so far, packed
+     * @param parent        split point of the task the node belongs to, nullptr if none
+     */
+    SplitPoint( const Reversi& position, const Reversi::Stone stone, const int depth, const int ply, const int alpha,
+                const int beta, const int bestScore, const int bestMove, const SplitPoint* parent )
+        : m_Position { position }
+        , m_Stone { stone }
+        , m_Depth { depth }
+        , m_Ply { ply }
+        , m_Beta { beta }
+        , m_Parent { parent }
+        , m_Alpha { alpha }
+        , m_BestScore { bestScore }
+        , m_BestMove { bestMove }
+    {}
+
+    /*! @brief check if this split point or one above it is cancelled
+     *
+     * @return              true if the result isn't needed any more
+     */
+    bool cancelled() const
+    {
+        for( const SplitPoint* split { this }; split; split = split->m_Parent )
+            if( split->m_Cutoff.load(std::memory_order_relaxed) )
+                return true;
+        return false;
+    }
+
+    /*! @brief check if a split point is this one or one below it
+     *
+     * @param split         split point to check
+     * @return              true if the split point belongs to the subtree of this one
+     */
+    bool contains( const SplitPoint* split ) const
+    {
+        for( ; split; split = split->m_Parent )
+            if( this == split )
+                return true;
+        return false;
+    }
+
+    /*! @brief report the score of a move
+     *
+     * @param score         score of the move
+     * @param move          move, packed
+     * @return              true if the move causes a cut-off
+     */
+    bool update( const int score, const int move )
+    {
+        std::lock_guard<std::mutex> lock { m_Mutex };
+
+        if( score > m_BestScore )
+        {
+            m_BestScore = score;
+            m_BestMove  = move;
+        }
+        if( score > m_Alpha )
+            m_Alpha = score;
+        if( score >= m_Beta )
+            m_Cutoff = true;
+
+        return m_Cutoff;
+    }
+
+    const Reversi           m_Position;                                 ///< position of the node
+    FieldList               m_Moves {};                                 ///< moves to search by the tasks
+    const Reversi::Stone    m_Stone;                                    ///< stone to move
+    const int               m_Depth;                                    ///< remaining depth of the node
+    const int               m_Ply;                                      ///< distance of the node to the root, the
+                                                                        ///      same for every thread searching it
+    const int               m_Beta;                                     ///< upper bound of the window
+    const SplitPoint*       m_Parent;                                   ///< split point above, nullptr if none
+
+    std::atomic<int>        m_Alpha;                                    ///< lower bound, raised by the results
+    std::atomic<int>        m_Unfinished { 0 };                         ///< tasks not done yet
+    std::atomic<bool>       m_Cutoff { false };                         ///< a move caused a cut-off
+
+    std::mutex              m_Mutex;                                    ///< guards the best score and move
+    int                     m_BestScore;                                ///< best score so far
+    int                     m_BestMove;                                 ///< best move so far, packed
+};
+
+// =====================================================================================================================
+
+/// @brief search of a single move of a split point
+struct SplitTask
+{
+    SplitPoint* m_Split { nullptr };                                    ///< split point of the move
+    int         m_Move { 0 };                                           ///< index of the move in its list
+};
+
+// =====================================================================================================================
+
+/*! @brief deque of tasks of one thread: it takes its own tasks from the back, other threads steal from the front
+ * @details The owner gets the tasks it just created, deep in the tree and likely in the cache, thieves get the oldest
+ * ones, closest to the root and thus the largest pieces of work. Access is guarded by a mutex, held just for the
+ * push or pop of a single task.
+ */
+class TaskQueue
+{
+public:
+    /*! @brief add a task at the back
+     *
+     * @param task      task to add
+     */
+    void push( const SplitTask& task )
+    {
+        std::lock_guard<std::mutex> lock { m_Mutex };
+        m_Tasks.push_back(task);
+    }
+
+    /*! @brief take the newest task, if it belongs to a split point
+     *
+     * @param task      task taken
+     * @param split     split point the task must belong to
+     * @return          true if a task was taken
+     */
+    bool pop( SplitTask& task, const SplitPoint* split )
+    {
+        std::lock_guard<std::mutex> lock { m_Mutex };
+
+        if( m_Tasks.empty() || m_Tasks.back().m_Split != split )
+            return false;
+
+        task = m_Tasks.back();
+        m_Tasks.pop_back();
+        return true;
+    }
+
+    /*! @brief steal the oldest task
+     *
+     * @param task      task taken
+     * @param subtree   only take a task of this split point or one below it, nullptr to take any
+     * @return          true if a task was taken
+     */
+    bool steal( SplitTask& task, const SplitPoint* subtree )
+    {
+        std::lock_guard<std::mutex> lock { m_Mutex };
+
+        if( m_Tasks.empty() || ( subtree && !subtree->contains(m_Tasks.front().m_Split) ) )
+            return false;
+
+        task = m_Tasks.front();
+        m_Tasks.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex              m_Mutex;                                    ///< guards the tasks
+    std::deque<SplitTask>   m_Tasks;                                    ///< tasks, newest at the back
+};
+
+// =====================================================================================================================
+
+/// @brief task queues of all threads of a search splitting its nodes
+struct SplitScheduler
+{
+    /*! @brief constructor
+     *
+     * @param numWorkers    number of threads, one queue each
+     */
+    explicit SplitScheduler( const int numWorkers )
+        : m_Queues { new TaskQueue[numWorkers] }
+        , m_NumWorkers { numWorkers }
+    {}
+
+    std::unique_ptr<TaskQueue[]>    m_Queues;                           ///< one queue per thread
+    const int                       m_NumWorkers;                       ///< number of threads
+    std::atomic<bool>               m_Done { false };                   ///< the main thread is done, the others
+                                                                        ///      leave when there is nothing to steal
+};
+
+#endif //WORKSTEALING_H
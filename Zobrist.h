@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2017 Volker Floeder
+// All rights reserved.
+//
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+
+#include "Pos_Vect.h"
+
+// =====================================================================================================================
+
+/*! @brief random keys to compute a hash value of a position
+ * @details Each combination of field and color has a fixed random 64-bit key. The hash of a position is the XOR of
+ * the keys of all stones on the board, so it can be updated incrementally: setting, removing or flipping a stone just
+ * XORs one or two keys. The side to move is added by XORing one more key. The keys are generated at compile time by a
+ * fixed pseudo random sequence (splitmix64), so they are the same in every run - hashes stored in files stay valid.
+ *
+ * The keys are laid out for the largest board, a position is x * 10 + y regardless of the actual board size.
+ */
+class Zobrist
+{
+public:
+    static constexpr const int m_MaxBoardSize { 10 };                       ///< largest board supported
+
+    /*! @brief get key of a stone on a field
+     *
+     * @param pos       position of the stone
+     * @param white     true for a white stone
+     * @return          key
+     */
+    static uint64_t stoneKey( const Pos_Vect& pos, const bool white )
+    { return m_StoneKeys[white ? 1 : 0][pos.getX() * m_MaxBoardSize + pos.getY()]; }
+
+    /*! @brief get key to XOR when white is to move
+     *
+     * @return          key
+     */
+    static constexpr uint64_t sideKey()
+    { return m_SideKey; }
+
+private:
+    using StoneKeys = std::array<std::array<uint64_t, m_MaxBoardSize * m_MaxBoardSize>, 2>;    ///< per color and field
+
+    /*! @brief next value of the splitmix64 sequence
+     *
+     * @param state     state of the sequence, advanced by one step
+     * @return          pseudo random value
+     */
+    static constexpr uint64_t splitMix( uint64_t& state )
+    {
+        uint64_t z { state += 0x9e3779b97f4a7c15ULL };
+
+        z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+        z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+        return z ^ ( z >> 31 );
+    }
+
+    /*! @brief generate all stone keys
+     *
+     * @return          table of keys
+     */
+    static constexpr StoneKeys makeStoneKeys()
+    {
+        StoneKeys   keys {};
+        uint64_t    state { 0x5265766572736921ULL };
+
+        for( auto& color : keys )
+        {
+            for( auto& key : color )
+            {
+                key = splitMix(state);
+            }
+        }
+        return keys;
+    }
+
+    static const StoneKeys              m_StoneKeys;                        ///< keys per color and field
+    static constexpr const uint64_t     m_SideKey { 0x8f1bbcdc6ed9eba1ULL };  ///< white to move
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// constant-initialized, the table is computed by the compiler
+inline const Zobrist::StoneKeys Zobrist::m_StoneKeys { Zobrist::makeStoneKeys() };
+
+#endif //ZOBRIST_H
@@ -21,7 +21,8 @@ int main()
     const int t_cols { 50 };
     const int t_rows { 25 };
     const int gridSize { 8 };
-    const int calcDepth { 5 };
+    const int calcDepth { 20 };                                                     // max. depth of a computed move
+    const int calcTimeMs { 1000 };                                                  // time budget of a computed move
 
     static const std::vector<std::string> helpText {
         { "Simple game of REVERSI" },
@@ -53,6 +54,11 @@ int main()
 
     GameHandler    game(gridView, reversi);
 
+    game.setThreads(static_cast<int>(std::thread::hardware_concurrency()));        // use all cores to compute a move
+    game.loadPatterns("reversi-patterns.bin");                                      // if missing: simple evaluation
+    game.loadBook("reversi-book-" + std::to_string(gridSize) + ".bin");             // if missing: search every move
+    game.loadDatabase("reversi-db-" + std::to_string(gridSize) + ".bin");           // small boards only
+
     // print some status info regarding the game
     auto statusPrint { [&gridView]( int cnt, int wcnt, int bcnt, int value, const std::string& line ) -> void
                        {
@@ -118,8 +124,9 @@ int main()
             // The calculation is done in an async thread so that it is possible to check for user input in parallel.
             // If the user decides to abort, we'll let the computation end gracefully but we set a flag to abort
             std::future<GameHandler::MoveInfo> moveInfo { std::async(std::launch::async,
-                                                                     [&game, thisMove, calcDepth]()
-                                                                     {return game.computeNextMove(thisMove, calcDepth);} ) };
+                                                                     [&game, thisMove, calcDepth, calcTimeMs]()
+                                                                     {return game.computeNextMove(thisMove, calcDepth,
+                                                                                                  calcTimeMs);} ) };
 
             while( std::future_status::ready != moveInfo.wait_for(std::chrono::milliseconds(50)) )
             {
@@ -146,6 +153,9 @@ int main()
             }
         }
 
+        if( wait4Move && Reversi::Stone::BlackStone == thisMove )                   // the engine thinks while the player
+            game.startPonder(Reversi::otherColor(thisMove), calcDepth);             //      does, on its expected move
+
         // possible to move, let the player choose from the list of valid moves
         while( wait4Move )                                                          // wait for player to select a position
         {